@@ -18,7 +18,10 @@ struct GDSArray
     size_t _count; // current count of elements,
     size_t _capacity; // array capacity,
     size_t _element_size; // size of each element,
-    void* _data; // address of array's data beginning.
+    void* _data; // address of array's data beginning,
+    int _storage; // how '_data' is allocated - one of GDS_ARR_STORAGE_* values,
+    size_t _mapped_size; // size in bytes of the memory mapping holding '_data'. Unused for GDS_ARR_STORAGE_HEAP,
+    int _fd; // file descriptor of the backing file for GDS_ARR_STORAGE_FILE, -1 otherwise.
 };
 
 #endif // __GDS_ARRAY_DEF_H__
@@ -0,0 +1,24 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_BITSET_DEF_H__
+#define __GDS_BITSET_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_BITSET_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_BITSET_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct GDSBitset
+{
+    uint64_t* _words; // bit i is bit (i % 64) of word (i / 64). Bits past '_bit_count' are always 0,
+    size_t _bit_count; // current count of bits,
+    size_t _word_capacity; // count of allocated words.
+};
+
+#endif // __GDS_BITSET_DEF_H__
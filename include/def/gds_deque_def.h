@@ -0,0 +1,24 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_DEQUE_DEF_H__
+#define __GDS_DEQUE_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_DEQUE_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_DEQUE_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#define __GDS_ARRAY_DEF_ALLOW__
+#include "gds_array_def.h"
+
+struct GDSDeque
+{
+    struct GDSArray _data; // ring buffer storage. Its capacity is always a power of two, its count is unused(0),
+    size_t _head; // slot index of the first element,
+    size_t _count; // current count of elements.
+};
+
+#endif // __GDS_DEQUE_DEF_H__
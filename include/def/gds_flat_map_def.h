@@ -0,0 +1,27 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_FLAT_MAP_DEF_H__
+#define __GDS_FLAT_MAP_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_FLAT_MAP_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_FLAT_MAP_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "gds_vector_def.h"
+
+struct GDSFlatMap
+{
+    struct GDSVector _keys; // keys, sorted in ascending order,
+    struct GDSVector _values; // values, value at index i belongs to the key at index i,
+    int (*_key_compare_func)(const void* key1, const void* key2); // orders the keys, qsort() contract.
+
+    void* _eytzinger_keys; // copy of the keys in Eytzinger(BFS) order, 1-based. NULL if the layout isn't built,
+    size_t* _eytzinger_index; // index into '_keys' for each slot of '_eytzinger_keys'.
+};
+
+#endif // __GDS_FLAT_MAP_DEF_H__
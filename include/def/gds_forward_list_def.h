@@ -13,6 +13,9 @@
 
 #include <stddef.h>
 
+#define __GDS_SLAB_DEF_ALLOW__
+#include "gds_slab_def.h"
+
 struct _GDSForwardListNodeBase
 {
     struct _GDSForwardListNodeBase* next;
@@ -26,6 +29,13 @@ struct GDSForwardList
     size_t _count;
     size_t _data_size;
 
+    struct _GDSForwardListNodeBase* _cache_node; // node last found by position, where the next search by position
+        // can continue from, or NULL,
+    size_t _cache_pos; // position of '_cache_node'.
+
+    struct GDSSlab _own_slab; // pool the nodes are allocated from, unless the list uses a shared pool,
+    struct GDSSlab* _shared_slab; // pool shared with other lists, or NULL.
+
     void (*_on_element_removal_func)(void*); // pointer to a callback function that is called on element removal, for each removed element.
         // void* parameter - address of data in node.
         // - The node may store pointers to dynamically allocated objects. This function can be used 
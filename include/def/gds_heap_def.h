@@ -0,0 +1,32 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_HEAP_DEF_H__
+#define __GDS_HEAP_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_HEAP_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_HEAP_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdbool.h>
+
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "gds_vector_def.h"
+
+struct GDSHeap
+{
+    struct GDSVector _data; // elements, in heap order,
+    int (*_compare_func)(const void*, const void*);
+    size_t _arity; // count of children of each node,
+    void* _hole_buff; // holds the element being sifted, so moves don't need swaps,
+
+    bool _indexed;
+    struct GDSVector _handles; // indexed heaps only: handle of the element at each position,
+    struct GDSVector _positions; // indexed heaps only: position of the element with each handle, or SIZE_MAX,
+    struct GDSVector _free_handles; // indexed heaps only: handles that can be reused.
+};
+
+#endif // __GDS_HEAP_DEF_H__
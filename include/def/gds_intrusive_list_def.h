@@ -0,0 +1,26 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_INTRUSIVE_LIST_DEF_H__
+#define __GDS_INTRUSIVE_LIST_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_INTRUSIVE_LIST_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_INTRUSIVE_LIST_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+
+struct GDSIntrusiveListNode;
+
+struct GDSIntrusiveList
+{
+    struct GDSIntrusiveListNode* _head;
+    struct GDSIntrusiveListNode* _tail;
+
+    size_t _count;
+};
+
+#endif // __GDS_INTRUSIVE_LIST_DEF_H__
@@ -0,0 +1,47 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#include "gds.h"
+
+#ifndef __GDS_LIST_DEF_H__
+#define __GDS_LIST_DEF_H__
+
+#ifndef __GDS_LIST_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_LIST_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+
+#define __GDS_SLAB_DEF_ALLOW__
+#include "gds_slab_def.h"
+
+// Element data is stored right after the node.
+struct _GDSListNode
+{
+    struct _GDSListNode* prev;
+    struct _GDSListNode* next;
+};
+
+struct GDSList
+{
+    struct _GDSListNode* _head;
+    struct _GDSListNode* _tail;
+
+    size_t _count;
+    size_t _data_size;
+
+    struct GDSSlab _own_slab; // pool the nodes are allocated from, unless the list uses a shared pool,
+    struct GDSSlab* _shared_slab; // pool shared with other lists, or NULL.
+
+    void (*_on_element_removal_func)(void*); // called on element removal, for each removed element. void* parameter
+        // - address of the element.
+};
+
+struct GDSListIterator
+{
+    struct _GDSListNode* _curr_node; // NULL after the last element was erased through the iterator,
+    size_t _pos;
+};
+
+#endif // __GDS_LIST_DEF_H__
@@ -0,0 +1,31 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_LOCKFREE_STACK_DEF_H__
+#define __GDS_LOCKFREE_STACK_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_LOCKFREE_STACK_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_LOCKFREE_STACK_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "gds_intrusive_list.h"
+
+// Top of the stack, paired with a tag that is incremented by every successful update. Both are swapped together by one
+// double-width compare-and-swap, so a top that was popped and pushed back in the meantime(ABA) still fails the swap.
+struct _GDSLockFreeStackHead
+{
+    _Alignas(2 * sizeof(void*)) struct GDSIntrusiveListNode* top;
+    uintptr_t tag;
+};
+
+struct GDSLockFreeStack
+{
+    _Alignas(GDS_CACHE_LINE_SIZE) struct _GDSLockFreeStackHead _head;
+};
+
+#endif // __GDS_LOCKFREE_STACK_DEF_H__
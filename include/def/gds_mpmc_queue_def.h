@@ -0,0 +1,29 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_MPMC_QUEUE_DEF_H__
+#define __GDS_MPMC_QUEUE_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_MPMC_QUEUE_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_MPMC_QUEUE_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+struct GDSMPMCQueue
+{
+    _Alignas(GDS_CACHE_LINE_SIZE) atomic_size_t _enqueue_pos; // next position producers will claim,
+    _Alignas(GDS_CACHE_LINE_SIZE) atomic_size_t _dequeue_pos; // next position consumers will claim.
+
+    // read-only after initialization.
+    _Alignas(GDS_CACHE_LINE_SIZE) size_t _capacity; // always a power of two,
+    size_t _element_size;
+    size_t _cell_size; // size of one cell - a sequence number followed by the element, padded for alignment,
+    void* _cells;
+};
+
+#endif // __GDS_MPMC_QUEUE_DEF_H__
@@ -0,0 +1,29 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_MPSC_QUEUE_DEF_H__
+#define __GDS_MPSC_QUEUE_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_MPSC_QUEUE_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_MPSC_QUEUE_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdatomic.h>
+
+#include "gds_intrusive_list.h"
+
+struct GDSMPSCQueue
+{
+    _Alignas(GDS_CACHE_LINE_SIZE) _Atomic(struct GDSIntrusiveListNode*) _head; // most recently pushed node, swapped
+        // in by producers,
+
+    // used only by the consumer.
+    _Alignas(GDS_CACHE_LINE_SIZE) struct GDSIntrusiveListNode* _tail; // oldest node, the next one to pop,
+    struct GDSIntrusiveListNode _stub; // placeholder node that keeps the queue non-empty, so producers never have to
+        // touch '_tail'.
+};
+
+#endif // __GDS_MPSC_QUEUE_DEF_H__
@@ -0,0 +1,63 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_POOL_DEF_H__
+#define __GDS_POOL_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_POOL_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_POOL_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define __GDS_MPMC_QUEUE_DEF_ALLOW__
+#include "gds_mpmc_queue_def.h"
+
+struct GDSPoolGroup
+{
+    atomic_size_t _pending; // count of submitted tasks of the group that haven't finished yet.
+};
+
+/* Slot of a worker's deque. Fields are atomic because a thief may read a slot while the owner writes it - the
+ * thief's read is only used if its compare-and-swap on '_top' proves that the slot wasn't reused. */
+struct _GDSPoolSlot
+{
+    void (* _Atomic _func)(void* ctx);
+    _Atomic(void*) _ctx;
+    _Atomic(struct GDSPoolGroup*) _group;
+};
+
+/* Worker thread with its Chase-Lev deque. The owner pushes and pops at the bottom, thieves steal from the top. */
+struct _GDSPoolWorker
+{
+    _Alignas(GDS_CACHE_LINE_SIZE) _Atomic int64_t _top; // written by thieves,
+    _Alignas(GDS_CACHE_LINE_SIZE) _Atomic int64_t _bottom; // written by the owner only,
+
+    _Alignas(GDS_CACHE_LINE_SIZE) struct _GDSPoolSlot* _slots; // GDS_POOL_DEQUE_CAPACITY slots,
+    struct GDSPool* _pool;
+    pthread_t _thread;
+    uint64_t _rng_state; // for choosing victims to steal from.
+};
+
+struct GDSPool
+{
+    struct _GDSPoolWorker* _workers;
+    size_t _worker_count;
+    struct GDSMPMCQueue _queue; // tasks submitted from threads that are not workers of the pool,
+
+    atomic_bool _stop;
+    atomic_size_t _sleeper_count; // count of workers sleeping on '_sleep_cond',
+    atomic_size_t _waiter_count; // count of threads sleeping on '_done_cond' in gds_pool_group_wait(),
+    pthread_mutex_t _mutex;
+    pthread_cond_t _sleep_cond;
+    pthread_cond_t _done_cond;
+};
+
+#endif // __GDS_POOL_DEF_H__
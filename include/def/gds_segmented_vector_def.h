@@ -0,0 +1,25 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_SEGMENTED_VECTOR_DEF_H__
+#define __GDS_SEGMENTED_VECTOR_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_SEGMENTED_VECTOR_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_SEGMENTED_VECTOR_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "gds_vector_def.h"
+
+struct GDSSegmentedVector
+{
+    struct GDSVector _segments; // directory - addresses(void*) of the allocated segments, in order,
+    size_t _count; // current count of elements,
+    size_t _element_size; // size of each element,
+    size_t _segment_shift; // log2 of the count of elements each segment holds.
+};
+
+#endif // __GDS_SEGMENTED_VECTOR_DEF_H__
@@ -0,0 +1,29 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_SERIAL_DEF_H__
+#define __GDS_SERIAL_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_SERIAL_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_SERIAL_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <sys/types.h>
+
+struct GDSSerialReader
+{
+    int _fd;
+    size_t _element_size;
+    size_t _count; // count of elements in the file,
+    size_t _remaining_count; // count of elements not yet returned,
+
+    char* _block; // buffer for one block of elements,
+    size_t _block_capacity; // count of elements the block holds,
+    off_t _offset; // file offset of the next element to read.
+};
+
+#endif // __GDS_SERIAL_DEF_H__
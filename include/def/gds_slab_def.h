@@ -0,0 +1,54 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_SLAB_DEF_H__
+#define __GDS_SLAB_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_SLAB_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_SLAB_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+
+// Header at the start of each chunk. Each chunk keeps its own free objects, so a chunk can be freed as soon as none of
+// its objects are in use.
+struct _GDSSlabChunk
+{
+    struct _GDSSlabChunk* prev; // links of the list of chunks that have objects left to allocate,
+    struct _GDSSlabChunk* next;
+
+    struct _GDSSlabFreeObject* free_list; // freed objects of this chunk,
+    char* carve_pos; // next never used object of this chunk,
+    char* objects_end; // end of the last object of this chunk,
+
+    size_t object_count;
+    size_t used_count;
+};
+
+// Freed objects are linked through their first bytes.
+struct _GDSSlabFreeObject
+{
+    struct _GDSSlabFreeObject* next;
+};
+
+struct GDSSlab
+{
+    size_t _object_size; // requested size, rounded up to a multiple of sizeof(void*),
+    size_t _chunk_objects; // object count of the next chunk to allocate,
+    size_t _max_chunk_objects; // '_chunk_objects' doubles with each chunk, up to this count,
+
+    struct _GDSSlabChunk** _chunks; // all chunks, sorted by address - used to find the chunk a freed object is in,
+    size_t _chunk_count;
+    size_t _chunks_capacity;
+
+    struct _GDSSlabChunk* _partial_chunks; // chunks with objects left to allocate; objects come from the first one,
+
+    size_t _capacity; // count of objects all chunks hold together,
+    size_t _used_count; // count of objects that are allocated and not freed,
+    size_t _peak_used_count; // highest '_used_count' so far - empty chunks are kept while they are needed to reach it.
+};
+
+#endif // __GDS_SLAB_DEF_H__
@@ -0,0 +1,26 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_SOA_VECTOR_DEF_H__
+#define __GDS_SOA_VECTOR_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_SOA_VECTOR_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_SOA_VECTOR_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#define __GDS_ARRAY_DEF_ALLOW__
+#include "gds_array_def.h"
+
+struct GDSSoAVector
+{
+    struct GDSArray* _columns; // one array per field. All columns hold '_count' elements,
+    size_t _field_count;
+    size_t _count; // current count of records,
+    size_t _capacity; // count of records every column can hold,
+    double _resize_factor;
+};
+
+#endif // __GDS_SOA_VECTOR_DEF_H__
@@ -0,0 +1,33 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_SPSC_QUEUE_DEF_H__
+#define __GDS_SPSC_QUEUE_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_SPSC_QUEUE_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_SPSC_QUEUE_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+struct GDSSPSCQueue
+{
+    // written by the consumer only.
+    _Alignas(GDS_CACHE_LINE_SIZE) atomic_size_t _head; // position of the next element to dequeue,
+    size_t _cached_tail; // the consumer's last observed value of '_tail'.
+
+    // written by the producer only.
+    _Alignas(GDS_CACHE_LINE_SIZE) atomic_size_t _tail; // position of the next free slot,
+    size_t _cached_head; // the producer's last observed value of '_head'.
+
+    // read-only after initialization.
+    _Alignas(GDS_CACHE_LINE_SIZE) size_t _capacity; // always a power of two,
+    size_t _element_size;
+    void* _data;
+};
+
+#endif // __GDS_SPSC_QUEUE_DEF_H__
@@ -0,0 +1,45 @@
+// INTERNAL HEADER FILE - DO NOT INCLUDE DIRECTLY.
+
+#ifndef __GDS_UNROLLED_LIST_DEF_H__
+#define __GDS_UNROLLED_LIST_DEF_H__
+
+#include "gds.h"
+
+#ifndef __GDS_UNROLLED_LIST_DEF_ALLOW__
+#error "Do not include directly."
+#endif // __GDS_UNROLLED_LIST_DEF_ALLOW__
+
+// ---------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+
+// Node holding up to '_node_capacity' elements of the list, stored contiguously after the header.
+struct _GDSUnrolledListNode
+{
+    struct _GDSUnrolledListNode* next;
+    size_t count; // count of elements in the node.
+};
+
+struct GDSUnrolledList
+{
+    struct _GDSUnrolledListNode* _head;
+    struct _GDSUnrolledListNode* _tail;
+
+    size_t _count; // count of elements in all nodes,
+    size_t _data_size;
+    size_t _node_capacity; // max count of elements per node,
+    size_t _node_size; // size of one node in bytes, a multiple of GDS_CACHE_LINE_SIZE,
+
+    void (*_on_element_removal_func)(void*); // called on element removal, for each removed element. void* parameter
+        // - address of the element.
+};
+
+struct GDSUnrolledListIterator
+{
+    struct _GDSUnrolledListNode* _curr_node;
+    size_t _index; // index of the current element inside '_curr_node',
+    size_t _pos; // index of the current element inside the list,
+    size_t _data_size; // copied from the list, to find elements inside nodes.
+};
+
+#endif // __GDS_UNROLLED_LIST_DEF_H__
@@ -49,6 +49,23 @@ structs not opaque. This can be done by commenting the macro below (GDS_ENABLE_O
 
 #define GDS_ENABLE_OPAQUE_STRUCTS
 
+// Debug checks --------------------------------------------------------------------------------------------------------
+
+/* The unchecked accessors in gds_unchecked.h don't validate their arguments. If GDS_DEBUG is defined(for example,
+ * with -DGDS_DEBUG), they check them with assert() instead. */
+
+// #define GDS_DEBUG
+
+// Cache line size -----------------------------------------------------------------------------------------------------
+
+/* Size of a cache line on the target, in bytes. Data structures that are shared between threads(concurrent queues,
+ * parallel algorithms) place independently written fields on separate cache lines of this size to avoid false
+ * sharing. 64 bytes is correct for current x86-64 and most ARM cores. */
+
+#ifndef GDS_CACHE_LINE_SIZE
+#define GDS_CACHE_LINE_SIZE 64
+#endif // GDS_CACHE_LINE_SIZE
+
 // ------------------------------------------------------------------------------------------------------------------------------------
 
 #endif // GDS_H
@@ -22,6 +22,27 @@ typedef struct GDSArray GDSArray;
 #define GDS_ARR_ERR_ARR_EMPTY 102
 #define GDS_ARR_ERR_MALLOC_FAIL 103
 #define GDS_ARR_ERR_REALLOC_FAIL 104
+#define GDS_ARR_ERR_MMAP_FAIL 105
+#define GDS_ARR_ERR_STORAGE_UNSUPPORTED 106
+#define GDS_ARR_ERR_FILE_OPEN_FAIL 107
+#define GDS_ARR_ERR_FILE_INVALID 108
+#define GDS_ARR_ERR_SYNC_FAIL 109
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Storage backends for the array's data. */
+#define GDS_ARR_STORAGE_HEAP 0 // malloc()/realloc() - the default,
+#define GDS_ARR_STORAGE_HUGE 1 // anonymous mmap(), grown with mremap() - see gds_array_init_huge(),
+#define GDS_ARR_STORAGE_FILE 2 // shared mmap() of a file - see gds_array_init_file().
+
+/* Mappings of GDS_ARR_STORAGE_HUGE arrays that are at least this large are rounded up to a multiple of
+ * GDS_ARR_HUGE_PAGE_SIZE and marked with madvise(MADV_HUGEPAGE). */
+#define GDS_ARR_HUGE_PAGE_THRESHOLD (4 * 1024 * 1024)
+#define GDS_ARR_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/* Size of the header at the start of files backing GDS_ARR_STORAGE_FILE arrays. The elements follow the header. */
+#define GDS_ARR_FILE_HEADER_SIZE 64
+#define GDS_ARR_FILE_VERSION 1
 
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -35,6 +56,53 @@ gds_err gds_array_init(GDSArray* array, size_t capacity, size_t element_size);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Initializes array with GDS_ARR_STORAGE_HUGE storage, meant for arrays that grow to gigabytes. Instead of malloc(),
+ * the data is placed in an anonymous private mmap() mapping. gds_array_realloc() resizes the mapping with mremap(),
+ * which extends it in place when the following address space is free and otherwise moves the page table entries -
+ * the data itself is never copied. Mappings of at least GDS_ARR_HUGE_PAGE_THRESHOLD bytes are rounded up to a
+ * multiple of GDS_ARR_HUGE_PAGE_SIZE and advised with MADV_HUGEPAGE, so that transparent huge pages can back them and
+ * TLB misses are reduced. Because the mapping is rounded up, the array's capacity may be greater than 'capacity'.
+ * Available on Linux only.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_ARR_ERR_MMAP_FAIL or
+ * GDS_ARR_ERR_STORAGE_UNSUPPORTED(if not on Linux).
+ * Function may fail if 'array' is NULL, 'capacity' == 0, 'element_size' == 0. */
+gds_err gds_array_init_huge(GDSArray* array, size_t capacity, size_t element_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Initializes array with GDS_ARR_STORAGE_FILE storage - the array's data is a shared memory mapping of the file
+ * at 'path'. The file starts with a GDS_ARR_FILE_HEADER_SIZE byte header holding the element size and count,
+ * followed by the elements themselves.
+ * If the file doesn't exist or is empty, it is created with room for 'capacity' elements. If it exists, the
+ * header is validated and the array's count and element size are restored from it without reading or copying any
+ * elements - they are paged in on first access. In that case, 'element_size' may be 0 to accept the element size
+ * stored in the file, and the capacity is the greater of 'capacity' and the stored count.
+ * Growing the array extends the file with ftruncate() and the mapping with mremap(). Modified elements reach the file
+ * through the page cache - gds_array_flush() must be called to store the current count in the header and to force
+ * the data to disk. gds_array_destruct() stores the count as well, but doesn't wait for the data to be written.
+ * Available on Linux only.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_ARR_ERR_FILE_OPEN_FAIL,
+ * GDS_ARR_ERR_FILE_INVALID(the file has an invalid header, or its element size doesn't match 'element_size'),
+ * GDS_ARR_ERR_MMAP_FAIL or GDS_ARR_ERR_STORAGE_UNSUPPORTED(if not on Linux).
+ * Function may fail if 'array' or 'path' are NULL or 'capacity' == 0. */
+gds_err gds_array_init_file(GDSArray* array, const char* path, size_t capacity, size_t element_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Stores the array's count in the header of its backing file and synchronously writes all modified pages to disk
+ * with msync(). If the array isn't a GDS_ARR_STORAGE_FILE array, the function performs no action.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument('array' is NULL) or
+ * GDS_ARR_ERR_SYNC_FAIL. */
+gds_err gds_array_flush(GDSArray* array);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Dynamically allocates memory for GDSArray. Calls gds_array_init() to initialize the newly created array.
  * Return value:
  * on success - address of dynamically allocated GDSArray. 
@@ -45,7 +113,9 @@ GDSArray* gds_array_create(size_t capacity, size_t element_size);
 // ---------------------------------------------------------------------------------------------------------------------
 
 /* Frees dynamically allocated memory for array. Sets values of array's fields to default values.
- * If array == NULL, the function performs no action. This doesn't free memory pointed to by 'array'. */
+ * If array == NULL, the function performs no action. This doesn't free memory pointed to by 'array'.
+ * For GDS_ARR_STORAGE_FILE arrays, the elements are kept - the count is stored in the file's header, and the file
+ * is unmapped and closed. */
 void gds_array_destruct(GDSArray* array);
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -136,6 +206,8 @@ gds_err gds_array_empty(GDSArray* array);
  * 2. A realloc() call will be performed. If the call succeeds, array's data will point to the new location.
  * If the call fails, array's data will point to the old location. If shrinking of the array occurred AND the realloc()
  * call failed, the array will remain shrunk.
+ * For GDS_ARR_STORAGE_HUGE and GDS_ARR_STORAGE_FILE arrays, mremap() is used instead of realloc() - see
+ * gds_array_init_huge() and gds_array_init_file().
  * Return value:
  * on success - GDS_SUCCESS,
  * on failure - one of gds generic error codes or GDS_ARR_ERR_REALLOC_FAIL.
@@ -144,10 +216,54 @@ gds_err gds_array_realloc(GDSArray* array, size_t capacity);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Finds the first element for which compare_func(element, 'data') returns 0. 
+ * Return value:
+ * on success - index of the found element,
+ * on failure - -1. Function may fail if any of the arguments are NULL or if no such element exists. */
 ssize_t gds_array_find(GDSArray* array, const void* data, bool (*compare_func)(const void*, const void*));
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Finds the first element whose bytes are equal to the 'element size' bytes pointed to by 'data'. No compare function
+ * is called - this is meant for elements that are compared bitwise(integers, pointers, handles, padding-free structs).
+ * On x86-64, elements of size 2, 4, 8 and 16 bytes are compared 16 bytes at a time with SSE2 instructions, and
+ * elements of size 1 are searched with memchr(). Other element sizes fall back to a memcmp() per element.
+ * Return value:
+ * on success - index of the found element,
+ * on failure - -1. Function may fail if 'array' or 'data' are NULL or if no such element exists. */
+ssize_t gds_array_find_bytes(const GDSArray* array, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sorts the array in ascending order, as defined by 'compare_func'. The sort is an introsort in the style of pdqsort:
+ * median-of-three(ninther for larger ranges) quicksort, insertion sort for small ranges, a partition that groups
+ * elements equal to the pivot so that inputs with many duplicates sort in linear time, and a heapsort fallback that
+ * guarantees O(n log n) in the worst case. Already sorted(or nearly sorted) inputs are detected and finished early.
+ * Elements are swapped in place by gds_misc_swap_inplace(), so no swap buffer is needed. The sort is not stable.
+ * 'compare_func' follows the qsort() contract: it returns a negative value if the first element is less than
+ * the second, 0 if they are equal and a positive value if the first element is greater.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'array' or 'compare_func' are NULL. */
+gds_err gds_array_sort(GDSArray* array, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sorts the array in ascending order by an integer key embedded in each element, using a stable LSD radix sort
+ * (one byte per pass). The key occupies 'key_width' bytes starting at byte 'key_offset' of each element and is
+ * interpreted as a native-endian integer - signed(two's complement) if 'key_signed' is true, unsigned otherwise.
+ * All digit histograms are built in a single pass over the data, and passes in which every key shares the same
+ * digit are skipped. The function allocates a scratch buffer the size of the array's data for the duration of the call.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_ARR_ERR_MALLOC_FAIL.
+ * Function may fail if 'array' is NULL, if 'key_width' is 0 or greater than 8, or if the key does not fit inside
+ * an element('key_offset' + 'key_width' > element size) - GDS_GEN_ERR_INCONSISTENT_ARGS is returned in that case. */
+gds_err gds_array_radix_sort(GDSArray* array, size_t key_offset, size_t key_width, bool key_signed);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Gets current count of elements in array. Assumes non-NULL argument. */
 size_t gds_array_get_count(const GDSArray* array);
 
@@ -168,6 +284,11 @@ size_t gds_array_get_element_size(const GDSArray* array);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Returns the storage backend of the array - one of GDS_ARR_STORAGE_* values. Assumes non-NULL argument. */
+int gds_array_get_storage(const GDSArray* array);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Performs sizeof(GDSArray) and returns the value. */
 size_t gds_array_get_struct_size();
 
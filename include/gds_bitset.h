@@ -0,0 +1,214 @@
+#ifndef _GDS_BITSET_H_
+#define _GDS_BITSET_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSBitset;
+#else
+#define __GDS_BITSET_DEF_ALLOW__
+#include "def/gds_bitset_def.h"
+#endif
+
+typedef struct GDSBitset GDSBitset;
+
+/* GDSBitset is a growable sequence of bits, packed into 64-bit words. Bits past the end of the bitset, in the last
+ * word, are kept at 0 - so counting and searching can work on whole words. Counting functions use the hardware
+ * popcount instruction(on x86-64, a version compiled for POPCNT is picked at load time if the CPU supports it). Bulk
+ * operations(AND, OR, XOR, ANDNOT) work on 128 bits at a time with SSE2 instructions, where available. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_BITSET_ERR_BASE 700
+#define GDS_BITSET_ERR_MALLOC_FAIL 701
+#define GDS_BITSET_ERR_REALLOC_FAIL 702
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the bitset to hold 'bit_count' bits, all set to 0. 'bit_count' may be 0.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_BITSET_ERR_MALLOC_FAIL.
+ * Function may fail if 'bitset' is NULL or if allocating memory for the bits fails. */
+gds_err gds_bitset_init(GDSBitset* bitset, size_t bit_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSBitset. Calls gds_bitset_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSBitset,
+ * on failure - NULL. The function can fail because: allocating memory for the new bitset failed, or because
+ * gds_bitset_init() returned an error code. */
+GDSBitset* gds_bitset_create(size_t bit_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the bits. If 'bitset' is NULL, the function performs no action. This doesn't
+ * free memory pointed to by 'bitset'. */
+void gds_bitset_destruct(GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets the bit at index 'pos' to 1.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'bitset' is NULL or if 'pos' is out of bounds. */
+gds_err gds_bitset_set(GDSBitset* bitset, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets the bit at index 'pos' to 0.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'bitset' is NULL or if 'pos' is out of bounds. */
+gds_err gds_bitset_clear(GDSBitset* bitset, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Flips the bit at index 'pos'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'bitset' is NULL or if 'pos' is out of bounds. */
+gds_err gds_bitset_flip(GDSBitset* bitset, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets the bit at index 'pos' to 'value'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'bitset' is NULL or if 'pos' is out of bounds. */
+gds_err gds_bitset_assign(GDSBitset* bitset, size_t pos, bool value);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the value of the bit at index 'pos'. Returns false if 'bitset' is NULL or if 'pos' is out of bounds. */
+bool gds_bitset_test(const GDSBitset* bitset, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets all bits to 1.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('bitset' is NULL). */
+gds_err gds_bitset_set_all(GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets all bits to 0.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('bitset' is NULL). */
+gds_err gds_bitset_clear_all(GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Changes the count of bits to 'new_bit_count'. Added bits are set to 0. Memory is reallocated only when growing
+ * past the allocated words - the allocation is then at least doubled.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_BITSET_ERR_REALLOC_FAIL.
+ * Function may fail if 'bitset' is NULL or if reallocating memory fails. */
+gds_err gds_bitset_resize(GDSBitset* bitset, size_t new_bit_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Appends a bit with value 'value'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_BITSET_ERR_REALLOC_FAIL.
+ * Function may fail if 'bitset' is NULL or if reallocating memory fails. */
+gds_err gds_bitset_push_back(GDSBitset* bitset, bool value);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of bits set to 1. Assumes non-NULL argument. */
+size_t gds_bitset_count(const GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of bits set to 1 among the bits at indices [0, 'pos'). 'pos' may be equal to the count of bits.
+ * Returns 0 if 'bitset' is NULL or if 'pos' is out of bounds. */
+size_t gds_bitset_rank(const GDSBitset* bitset, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Finds the bit set to 1 which has 'rank' bits set to 1 before it - the ('rank' + 1)-th set bit.
+ * Return value:
+ * on success - index of the found bit,
+ * on failure - -1. Function may fail if 'bitset' is NULL or if fewer than 'rank' + 1 bits are set. */
+ssize_t gds_bitset_select(const GDSBitset* bitset, size_t rank);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Finds the first bit set to 1 at index 'from' or after it.
+ * Return value:
+ * on success - index of the found bit,
+ * on failure - -1. Function may fail if 'bitset' is NULL or if no such bit exists. */
+ssize_t gds_bitset_find_first_set(const GDSBitset* bitset, size_t from);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Finds the first bit set to 0 at index 'from' or after it.
+ * Return value:
+ * on success - index of the found bit,
+ * on failure - -1. Function may fail if 'bitset' is NULL or if no such bit exists. */
+ssize_t gds_bitset_find_first_clear(const GDSBitset* bitset, size_t from);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs 'dest' = 'dest' AND 'src', bit by bit.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_GEN_ERR_INCONSISTENT_ARGS.
+ * Function may fail if 'dest' or 'src' are NULL, or if the bitsets hold different counts of bits. */
+gds_err gds_bitset_and(GDSBitset* dest, const GDSBitset* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs 'dest' = 'dest' OR 'src', bit by bit. Return values are the same as for gds_bitset_and(). */
+gds_err gds_bitset_or(GDSBitset* dest, const GDSBitset* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs 'dest' = 'dest' XOR 'src', bit by bit. Return values are the same as for gds_bitset_and(). */
+gds_err gds_bitset_xor(GDSBitset* dest, const GDSBitset* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs 'dest' = 'dest' AND (NOT 'src'), bit by bit - clears the bits of 'dest' that are set in 'src'. Return
+ * values are the same as for gds_bitset_and(). */
+gds_err gds_bitset_andnot(GDSBitset* dest, const GDSBitset* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the first word of the bitset. Bit i is bit (i % 64) of word (i / 64). Bits past the end of
+ * the bitset must be left at 0. Returns NULL if 'bitset' is NULL. */
+uint64_t* gds_bitset_get_words(const GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of words that hold the bits of the bitset. Assumes non-NULL argument. */
+size_t gds_bitset_get_word_count(const GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of bits. Assumes non-NULL argument. */
+size_t gds_bitset_get_bit_count(const GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSBitset) and returns the value. */
+size_t gds_bitset_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_BITSET_H_
@@ -0,0 +1,204 @@
+#ifndef _GDS_DEQUE_H_
+#define _GDS_DEQUE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSDeque;
+#else
+#define __GDS_DEQUE_DEF_ALLOW__
+#include "def/gds_deque_def.h"
+#endif
+
+typedef struct GDSDeque GDSDeque;
+
+/* GDSDeque is a double-ended queue implemented as a growable circular buffer on top of a GDSArray. Pushing and
+ * popping at both ends is O(1)(amortized, for pushes), as is access by index. Elements are stored contiguously,
+ * except that the sequence may wrap around the end of the buffer - gds_deque_get_segments() exposes the (at most two)
+ * contiguous segments, so elements can be copied out in bulk. The capacity is always a power of two, so that
+ * positions are mapped to slots with a mask. */
+
+#define GDS_DEQUE_DEFAULT_INITIAL_CAPACITY 16
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_DEQUE_ERR_BASE 400
+#define GDS_DEQUE_ERR_DEQUE_EMPTY 401
+#define GDS_DEQUE_ERR_MALLOC_FAIL 402
+#define GDS_DEQUE_ERR_REALLOC_FAIL 403
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the deque. Used when opaque structs are disabled. May also be used for initializing a deque after its
+ * destruction. Dynamically allocates enough memory to hold 'initial_capacity' elements, rounded up to a power of two.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_DEQUE_ERR_MALLOC_FAIL.
+ * Function may fail if 'deque' is NULL, 'element_size' == 0 or 'initial_capacity' == 0. */
+gds_err gds_deque_init(GDSDeque* deque, size_t element_size, size_t initial_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSDeque. Calls gds_deque_init() to initialize the newly created deque.
+ * Return value:
+ * on success - address of dynamically allocated GDSDeque,
+ * on failure - NULL. The function can fail because: allocating memory for the new deque failed, or because
+ * gds_deque_init() returned an error code. */
+GDSDeque* gds_deque_create(size_t element_size, size_t initial_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the deque. If 'deque' is NULL, the function performs no action.
+ * This doesn't free memory pointed to by 'deque'. */
+void gds_deque_destruct(GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calculates address of element with index specified by 'pos'(index 0 being the front of the deque).
+ * Return value:
+ * on success: address of element with index specified by 'pos',
+ * on failure: NULL. Function may fail if 'pos' is out of bounds or if 'deque' is NULL. */
+void* gds_deque_at(const GDSDeque* deque, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns address of the first element, or NULL if 'deque' is NULL or empty. */
+void* gds_deque_front(const GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns address of the last element, or NULL if 'deque' is NULL or empty. */
+void* gds_deque_back(const GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies memory content pointed to by 'data' into the deque at 'pos'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'deque' or 'data' are NULL or 'pos' is out of bounds. */
+gds_err gds_deque_assign(GDSDeque* deque, const void* data, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Appends the element pointed to by 'data' to the back of the deque. If the deque is full, its capacity is doubled.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_DEQUE_ERR_REALLOC_FAIL.
+ * Function may fail if 'deque' or 'data' are NULL, or if growing the deque fails. */
+gds_err gds_deque_push_back(GDSDeque* deque, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Prepends the element pointed to by 'data' to the front of the deque. If the deque is full, its capacity is doubled.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_DEQUE_ERR_REALLOC_FAIL.
+ * Function may fail if 'deque' or 'data' are NULL, or if growing the deque fails. */
+gds_err gds_deque_push_front(GDSDeque* deque, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Appends 'count' elements, stored contiguously at 'data', to the back of the deque with at most two memcpy() calls.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_DEQUE_ERR_REALLOC_FAIL.
+ * Function may fail if 'deque' or 'data' are NULL, or if growing the deque fails. In that case, no elements are
+ * appended. */
+gds_err gds_deque_push_back_n(GDSDeque* deque, const void* data, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the last element of the deque.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument('deque' is NULL) or
+ * GDS_DEQUE_ERR_DEQUE_EMPTY. */
+gds_err gds_deque_pop_back(GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the first element of the deque.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument('deque' is NULL) or
+ * GDS_DEQUE_ERR_DEQUE_EMPTY. */
+gds_err gds_deque_pop_front(GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the first 'count' elements of the deque in O(1). If 'count' is greater than the deque's count, the deque
+ * is emptied.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument('deque' is NULL). */
+gds_err gds_deque_pop_front_n(GDSDeque* deque, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the contiguous segments holding the deque's elements, in order. The first segment starts at the front
+ * of the deque. If the elements wrap around the end of the buffer, the rest of them are in the second segment -
+ * otherwise '*second' is set to NULL and '*second_count' to 0. The addresses stay valid until the next push.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if any of the arguments are NULL). */
+gds_err gds_deque_get_segments(const GDSDeque* deque, void** first, size_t* first_count,
+        void** second, size_t* second_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies 'count' elements, starting with the element at index 'pos', into 'dest' with at most two memcpy() calls.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'deque' or 'dest' are NULL, or if the range ['pos', 'pos' + 'count') is out of bounds. */
+gds_err gds_deque_copy_out(const GDSDeque* deque, void* dest, size_t pos, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Empties the deque in O(1).
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('deque' is NULL). */
+gds_err gds_deque_empty(GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reserves enough memory to fit 'new_capacity' elements(rounded up to a power of two). If the deque can already
+ * fit 'new_capacity' elements, the function performs no action.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument or GDS_DEQUE_ERR_REALLOC_FAIL. */
+gds_err gds_deque_reserve(GDSDeque* deque, size_t new_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current count of elements in the deque. Assumes non-NULL argument. */
+size_t gds_deque_get_count(const GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current capacity of the deque. Assumes non-NULL argument. */
+size_t gds_deque_get_capacity(const GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the deque is empty. Assumes non-NULL argument. */
+bool gds_deque_is_empty(const GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns element size of the deque. Assumes non-NULL argument. */
+size_t gds_deque_get_element_size(const GDSDeque* deque);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSDeque) and returns the value. */
+size_t gds_deque_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_DEQUE_H_
@@ -0,0 +1,179 @@
+#ifndef _GDS_FLAT_MAP_H_
+#define _GDS_FLAT_MAP_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSFlatMap;
+#else
+#define __GDS_FLAT_MAP_DEF_ALLOW__
+#include "def/gds_flat_map_def.h"
+#endif
+
+typedef struct GDSFlatMap GDSFlatMap;
+
+/* GDSFlatMap is an ordered associative container. Keys and values are kept in two separate contiguous arrays,
+ * with the keys sorted by the user-provided 'key_compare_func'. Lookups are performed by a branchless binary search,
+ * so no memory is spent on buckets or nodes, and the map supports ordered scans and range queries by index.
+ * Insertion and removal are O(n), as they shift the arrays - the container is meant for read-mostly data, ideally
+ * built in bulk with gds_flat_map_build().
+ * For large read-only maps, gds_flat_map_build_eytzinger() additionally stores a copy of the keys in Eytzinger(BFS)
+ * order. Searching that layout touches memory in a predictable, prefetch-friendly pattern. The layout is discarded
+ * on the next modification of the map. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_FLATMAP_ERR_BASE 300
+#define GDS_FLATMAP_ERR_MALLOC_FAIL 301
+#define GDS_FLATMAP_ERR_REALLOC_FAIL 302
+#define GDS_FLATMAP_ERR_KEY_NOT_FOUND 303
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the flat map. Used when opaque structs are disabled. May also be used for initializing a map after
+ * its destruction. 'key_compare_func' follows the qsort() contract: it returns a negative value if the first key is
+ * less than the second, 0 if they are equal and a positive value if the first key is greater.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_FLATMAP_ERR_MALLOC_FAIL.
+ * Function may fail if 'flat_map' or 'key_compare_func' are NULL, or if 'key_data_size' or 'value_data_size' are 0. */
+gds_err gds_flat_map_init(GDSFlatMap* flat_map, size_t key_data_size, size_t value_data_size,
+        int (*key_compare_func)(const void* key1, const void* key2));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSFlatMap. Calls gds_flat_map_init() to initialize the newly created map.
+ * Return value:
+ * on success - address of dynamically allocated GDSFlatMap,
+ * on failure - NULL. The function can fail because: allocating memory for the new map failed, or because
+ * gds_flat_map_init() returned an error code. */
+GDSFlatMap* gds_flat_map_create(size_t key_data_size, size_t value_data_size,
+        int (*key_compare_func)(const void* key1, const void* key2));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the map. If 'flat_map' is NULL, the function performs no action.
+ * This doesn't free memory pointed to by 'flat_map'. */
+void gds_flat_map_destruct(GDSFlatMap* flat_map);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Replaces the content of the map with 'count' entries. 'keys' and 'values' point to arrays of 'count' keys and
+ * 'count' values, in any order. Entries are sorted with gds_array_sort() in O(n log n), which is much faster than
+ * 'count' calls to gds_flat_map_set(). If 'keys' contains duplicates, only one of the duplicate entries is kept -
+ * which one is unspecified. If 'count' is 0, 'keys' and 'values' may be NULL and the map is emptied.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_FLATMAP_ERR_MALLOC_FAIL or
+ * GDS_FLATMAP_ERR_REALLOC_FAIL. On failure, the map is left empty. */
+gds_err gds_flat_map_build(GDSFlatMap* flat_map, const void* keys, const void* values, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets the value for 'key'. If the key isn't present in the map, a new entry is inserted at its sorted position,
+ * which shifts all greater entries - O(n). Otherwise, only the value is overwritten - O(log n).
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_FLATMAP_ERR_REALLOC_FAIL. */
+gds_err gds_flat_map_set(GDSFlatMap* flat_map, const void* key, const void* value);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the address of the value stored for 'key'. The address stays valid until the next modification.
+ * Return value:
+ * on success - address of the value,
+ * on failure - NULL. Function may fail if 'flat_map' or 'key' are NULL, or if the key isn't present. */
+void* gds_flat_map_get(const GDSFlatMap* flat_map, const void* key);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if 'key' is present in the map. Assumes non-NULL arguments. */
+bool gds_flat_map_contains(const GDSFlatMap* flat_map, const void* key);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the entry for 'key'. This shifts all greater entries - O(n).
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_FLATMAP_ERR_KEY_NOT_FOUND. */
+gds_err gds_flat_map_remove(GDSFlatMap* flat_map, const void* key);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Empties the map. If the map is already empty, the function performs no work and returns GDS_SUCCESS.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('flat_map' is NULL). */
+gds_err gds_flat_map_empty(GDSFlatMap* flat_map);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the index of the first entry whose key is not less than 'key', or the map's count if there is no such
+ * entry. Uses the Eytzinger layout if it is built. Assumes non-NULL arguments. */
+size_t gds_flat_map_lower_bound(const GDSFlatMap* flat_map, const void* key);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the index of the first entry whose key is greater than 'key', or the map's count if there is no such
+ * entry. Uses the Eytzinger layout if it is built. Assumes non-NULL arguments. */
+size_t gds_flat_map_upper_bound(const GDSFlatMap* flat_map, const void* key);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Finds the entries with keys in range ['low_key', 'high_key'). On return, '*first' holds the index of the first such
+ * entry and '*last' the index one past the last one - the range is empty if '*first' == '*last'. Entries can then
+ * be scanned in order with gds_flat_map_key_at() and gds_flat_map_value_at().
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if any of the arguments are NULL. */
+gds_err gds_flat_map_range(const GDSFlatMap* flat_map, const void* low_key, const void* high_key,
+        size_t* first, size_t* last);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the address of the key with index 'pos'(keys are in ascending order).
+ * Return value:
+ * on success: address of the key,
+ * on failure: NULL. Function may fail if 'flat_map' is NULL or 'pos' is out of bounds. */
+const void* gds_flat_map_key_at(const GDSFlatMap* flat_map, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the address of the value belonging to the key with index 'pos'.
+ * Return value:
+ * on success: address of the value,
+ * on failure: NULL. Function may fail if 'flat_map' is NULL or 'pos' is out of bounds. */
+void* gds_flat_map_value_at(const GDSFlatMap* flat_map, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Builds the Eytzinger layout of the keys, used by all subsequent lookups until the map is modified. This costs
+ * an additional copy of the keys plus one size_t per entry. Calling the function while the layout is already built
+ * performs no work.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_FLATMAP_ERR_MALLOC_FAIL. */
+gds_err gds_flat_map_build_eytzinger(GDSFlatMap* flat_map);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current count of entries in the map. Assumes non-NULL argument. */
+size_t gds_flat_map_get_count(const GDSFlatMap* flat_map);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the map is empty. Assumes non-NULL argument. */
+bool gds_flat_map_is_empty(const GDSFlatMap* flat_map);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSFlatMap) and returns the value. */
+size_t gds_flat_map_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_FLAT_MAP_H_
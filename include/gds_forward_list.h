@@ -5,6 +5,7 @@
 #include <stdbool.h>
 
 #include "gds.h"
+#include "gds_slab.h"
 
 #ifdef GDS_ENABLE_OPAQUE_STRUCTS
 struct GDSForwardList;
@@ -17,6 +18,13 @@ struct GDSForwardListIterator;
 typedef struct GDSForwardList GDSForwardList;
 typedef struct GDSForwardListIterator GDSForwardListIterator;
 
+/* Nodes of a list are allocated from a GDSSlab pool, not one by one with malloc(). By default, each list has its own
+ * pool: nodes pushed one after another are placed next to each other, removed nodes are reused by the following
+ * pushes, and the pool's memory is released all at once when the list is emptied or destructed. The pool starts
+ * with room for a few nodes and grows geometrically, so a short list stays small. Lists with the same data size can
+ * instead share a pool(gds_forward_list_init_shared()), which keeps memory from piling up in many mostly empty
+ * lists. */
+
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
 #define GDS_FWDLIST_ERR_BASE 2100
@@ -37,6 +45,18 @@ gds_err gds_forward_list_init(GDSForwardList* list, size_t data_size, void (*_on
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Initializes 'list' like gds_forward_list_init(), but nodes are allocated from 'slab', which may be shared by other
+ * lists. The slab's object size must be at least gds_forward_list_get_node_size('data_size'). The slab must outlive
+ * the list - destructing the list returns its nodes to the slab, but doesn't destruct it.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_GEN_ERR_INCONSISTENT_ARGS(if the
+ * slab's objects are too small). */
+gds_err gds_forward_list_init_shared(GDSForwardList* list, size_t data_size, void (*_on_element_removal_func)(void*),
+        GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Dynamically allocates memory for a GDSForwardList. Performs a call to gds_forward_list_init() to initialize it.
  * Return value:
  * on success: address of newly allocated GDSForwardList,
@@ -46,8 +66,15 @@ GDSForwardList* gds_forward_list_create(size_t data_size, void (*_on_element_rem
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Same as gds_forward_list_create(), but performs a call to gds_forward_list_init_shared(). */
+GDSForwardList* gds_forward_list_create_shared(size_t data_size, void (*_on_element_removal_func)(void*),
+        GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Used as a destructor. Sets values of 'list' fields to default values.
- * Removes all elements from the list(invocations of list->_on_element_removal_func will be made).
+ * Removes all elements from the list(invocations of list->_on_element_removal_func will be made). If the list has its
+ * own node pool, the pool's memory is released in bulk.
  * If 'list' is NULL, function performs nothing. This doesn't free memory pointed to by 'list'. */
 void gds_forward_list_destruct(GDSForwardList* list);
 
@@ -55,7 +82,13 @@ void gds_forward_list_destruct(GDSForwardList* list);
 
 /* Retrieves address of element with index 'pos' inside the list. This retrieves the data from the list directly
  * (not the internally used list nodes). If attempting to retrieve the list head or tail, the complexity will be O(1),
- * as both are stored inside the GDSForwardList structure. Otherwise, it's O(n).
+ * as both are stored inside the GDSForwardList structure. Otherwise, it's O(n). The list remembers the last node found
+ * by position, and a search for the same or a later position continues from it - so accessing elements with
+ * increasing 'pos'(for example, in a loop) costs O(1) per access. A search for an earlier position starts from the
+ * head.
+ * Even though 'list' is const, remembering the found node writes to the list. Concurrent calls on the same list -
+ * even read-only ones - need external synchronization. The same applies to gds_forward_list_assign() and
+ * gds_forward_list_swap().
  * Return value:
  * on success: address of element with index 'pos',
  * on failure: NULL. Function may fail if provided 'list' argument is NULL or if 'pos' is out of bounds. */
@@ -63,7 +96,8 @@ void* gds_forward_list_at(const GDSForwardList* list, size_t pos);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-/* Assigns data pointed to by 'data' to element with index 'pos' inside the list. This is done via memcpy().
+/* Assigns data pointed to by 'data' to element with index 'pos' inside the list. This is done via memcpy(). Finds the
+ * element like gds_forward_list_at(), updating the remembered node.
  * Return value:
  * on success: GDS_SUCCESS,
  * on failure: one of the generic error codes representing invalid arguments.
@@ -73,7 +107,8 @@ gds_err gds_forward_list_assign(GDSForwardList* list, const void* data, size_t p
 // ---------------------------------------------------------------------------------------------------------------------
 
 /* Functions swaps data of elements with indices 'pos1' and 'pos2'. Function performs no action if pos1 == pos2.
- * Make sure that swap_buff is of at least list->data_size size.
+ * Make sure that swap_buff is of at least list->data_size size. Finds the elements like gds_forward_list_at(),
+ * updating the remembered node.
  * Return value:
  * on success: GDS_SUCCESS,
  * on failure: one of the generic error codes representing invalid arguments.
@@ -133,8 +168,110 @@ gds_err gds_forward_list_remove_at(GDSForwardList* list, size_t pos);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Function inserts a new element right after the element 'iterator' points at, in O(1) complexity. 'iterator' must
+ * belong to 'list'. The iterator keeps pointing at the same element, so the new element is the next one it moves to.
+ * To insert at the start of the list, use gds_forward_list_push_front().
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_FWDLIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list', 'iterator' or 'data' are NULL, or if dynamic allocation of the new node fails. */
+gds_err gds_forward_list_insert_after(GDSForwardList* list, GDSForwardListIterator* iterator, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes the element right after the element 'iterator' points at, in O(1) complexity. 'iterator' must
+ * belong to 'list'. The iterator keeps pointing at the same element. To remove the first element of the list, use
+ * gds_forward_list_pop_front().
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_FWDLIST_ITER_ERR_OUT_OF_BOUNDS.
+ * Function may fail if 'list' or 'iterator' are NULL, or if the iterator points at the last element. */
+gds_err gds_forward_list_erase_after(GDSForwardList* list, GDSForwardListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes every element for which 'pred' returns true, in a single pass over the list. 'pred' receives the
+ * address of the element and 'ctx'. The order of the remaining elements is kept.
+ * This function will invoke list->_on_element_removal_func for each removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'pred' are NULL). */
+gds_err gds_forward_list_remove_if(GDSForwardList* list, bool (*pred)(const void* data, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sorts the list in ascending order, as defined by 'compare_func'. The sort is a bottom-up merge sort that only
+ * relinks the nodes - no memory is allocated and no element is copied, so addresses of elements stay valid. The sort
+ * is stable and runs in O(n log n) complexity.
+ * 'compare_func' follows the qsort() contract: it returns a negative value if the first element is less than
+ * the second, 0 if they are equal and a positive value if the first is greater than the second.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments.
+ * Function may fail if 'list' or 'compare_func' are NULL. */
+gds_err gds_forward_list_sort(GDSForwardList* list, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Merges the elements of 'src' into 'dest'. Both lists must already be sorted by 'compare_func'. The result is
+ * sorted, and equal elements of 'dest' come before those of 'src'. After the call, 'src' is empty. Elements are moved,
+ * not removed, so no calls to _on_element_removal_func are made.
+ * The nodes of 'src' are relinked into 'dest' the same way as in gds_forward_list_splice_back(): if both lists
+ * allocate nodes from the same shared slab, or if 'src' has its own slab, no memory is allocated and the elements of
+ * 'src' keep their addresses. Elements are copied only in the cases described there. If 'dest' and 'src' are the
+ * same list, the function performs no action.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments, GDS_GEN_ERR_INCONSISTENT_ARGS(if the
+ * lists have different data sizes) or GDS_FWDLIST_ERR_MALLOC_FAIL. If the function fails, both lists are unchanged. */
+gds_err gds_forward_list_merge(GDSForwardList* dest, GDSForwardList* src,
+        int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves all elements of 'src' to the end of 'dest'. After the call, 'src' is empty. Elements are moved, not removed,
+ * so no calls to _on_element_removal_func are made.
+ * Usually, the whole chain of nodes of 'src' is relinked without copying or allocating, so elements keep their
+ * addresses: either both lists allocate nodes from the same shared slab(see gds_forward_list_init_shared()), or 'src'
+ * has its own slab, whose memory is then handed over to the slab of 'dest'(see gds_slab_absorb()). Each element is
+ * copied into a node allocated from the slab of 'dest', in O(n) complexity, only if 'src' uses a different shared
+ * slab, or if the slab of 'dest' is shared and has larger objects than the own slab of 'src'.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments, GDS_GEN_ERR_INCONSISTENT_ARGS(if
+ * 'dest' and 'src' are the same list or have different data sizes) or GDS_FWDLIST_ERR_MALLOC_FAIL. If the function
+ * fails, both lists are unchanged. */
+gds_err gds_forward_list_splice_back(GDSForwardList* dest, GDSForwardList* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as gds_forward_list_splice_back(), but the elements of 'src' are inserted right after the element 'iterator'
+ * points at. 'iterator' must belong to 'dest' and keeps pointing at the same element. */
+gds_err gds_forward_list_splice_after(GDSForwardList* dest, GDSForwardListIterator* iterator, GDSForwardList* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves all elements after the element 'iterator' points at from 'list' to the end of 'dest'. The element 'iterator'
+ * points at becomes the last element of 'list'. 'iterator' must belong to 'list'. The moved elements are counted by
+ * walking them, so the function takes O(n) complexity in the number of moved elements. The moved nodes are relinked
+ * without copying only if both lists allocate nodes from the same shared slab(see gds_forward_list_init_shared()).
+ * Otherwise - including for two lists created with gds_forward_list_init() - each moved element is copied into a new
+ * node allocated from the slab of 'dest', so the moved elements get new addresses. Unlike in
+ * gds_forward_list_splice_back(), only part of the nodes of 'list' is moved, and the chunks of its slab also hold the
+ * nodes that stay, so they can't be handed over. To split without copying, let both lists share one slab.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments, GDS_GEN_ERR_INCONSISTENT_ARGS(if
+ * 'list' and 'dest' are the same list or have different data sizes) or GDS_FWDLIST_ERR_MALLOC_FAIL. If the function
+ * fails, both lists are unchanged. */
+gds_err gds_forward_list_split_at(GDSForwardList* list, GDSForwardListIterator* iterator, GDSForwardList* dest);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Function empties the list. 
- * This function will invoke list->_on_element_removal_func for each removed element, if non-NULL. 
+ * This function will invoke list->_on_element_removal_func for each removed element, if non-NULL. If the list has its
+ * own node pool, all nodes are released at once and the pool's memory is returned to the system.
  * If the list is already empty, the function performs no action and returns GDS_SUCCESS.
  * Return value:
  * on success: GDS_SUCCESS,
@@ -158,6 +295,12 @@ bool gds_forward_list_is_empty(const GDSForwardList* list);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Returns the size of one list node holding data of size 'data_size' - the object size a slab shared by such lists
+ * must have. */
+size_t gds_forward_list_get_node_size(size_t data_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Performs sizeof(GDSForwardList) and returns the value. */
 size_t gds_forward_list_get_struct_size();
 
@@ -0,0 +1,221 @@
+#ifndef _GDS_HEAP_H_
+#define _GDS_HEAP_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+#include "gds_vector.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSHeap;
+#else
+#define __GDS_HEAP_DEF_ALLOW__
+#include "def/gds_heap_def.h"
+#endif
+
+typedef struct GDSHeap GDSHeap;
+
+/* GDSHeap is a priority queue - a d-ary heap stored in a GDSVector. The order is defined by 'compare_func', in the
+ * style of gds_array_sort(): it returns a negative value if the first element should come before the second, 0 if
+ * they are equal and a positive value otherwise. The top of the heap is the element that comes first - the smallest
+ * one, for an ascending comparison function. Pass a reversed comparison function for a max-heap.
+ * Each node has 'arity' children. A higher arity makes the heap shallower and its nodes' children adjacent in memory,
+ * which makes pushing and sifting down cheaper in cache misses at the cost of more comparisons per level. Elements are
+ * moved with memcpy() into a hole, not swapped.
+ *
+ * An indexed heap(gds_heap_init_indexed()) also assigns a handle to each pushed element. The handle stays valid while
+ * the element is in the heap, regardless of how it is moved, and can be used to read, remove or change the priority
+ * of the element(gds_heap_decrease_key()). Handles of popped or removed elements are reused. */
+
+#define GDS_HEAP_DEFAULT_ARITY 4
+#define GDS_HEAP_DEFAULT_INITIAL_CAPACITY 10
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_HEAP_ERR_BASE 900
+#define GDS_HEAP_ERR_HEAP_EMPTY 901
+#define GDS_HEAP_ERR_MALLOC_FAIL 902
+#define GDS_HEAP_ERR_REALLOC_FAIL 903
+#define GDS_HEAP_ERR_NOT_INDEXED 904
+#define GDS_HEAP_ERR_INDEXED 905
+#define GDS_HEAP_ERR_INVALID_HANDLE 906
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the heap for elements of size 'element_size', where each node has 'arity' children.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_HEAP_ERR_MALLOC_FAIL.
+ * Function may fail if 'heap' or 'compare_func' are NULL, if 'element_size' == 0 or if 'arity' < 2. */
+gds_err gds_heap_init(GDSHeap* heap, size_t element_size, size_t arity, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs a call to gds_heap_init(). Passes GDS_HEAP_DEFAULT_ARITY as 'arity'. */
+gds_err gds_heap_init_default(GDSHeap* heap, size_t element_size, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Initializes an indexed heap - see the description at the top of the file. Arguments and return values are the same
+ * as for gds_heap_init(). */
+gds_err gds_heap_init_indexed(GDSHeap* heap, size_t element_size, size_t arity,
+        int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSHeap. Calls gds_heap_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSHeap,
+ * on failure - NULL. The function can fail because: allocating memory for the new heap failed, or because
+ * gds_heap_init() returned an error code. */
+GDSHeap* gds_heap_create(size_t element_size, size_t arity, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as gds_heap_create(), but calls gds_heap_init_indexed(). */
+GDSHeap* gds_heap_create_indexed(size_t element_size, size_t arity, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the elements and handles. If 'heap' is NULL, the function performs no
+ * action. This doesn't free memory pointed to by 'heap'. */
+void gds_heap_destruct(GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Adds a copy of the element pointed to by 'data' to the heap. If the heap is indexed and 'out_handle' is not NULL,
+ * the element's handle is stored into it. 'out_handle' is ignored for heaps that aren't indexed.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_HEAP_ERR_REALLOC_FAIL.
+ * Function may fail if 'heap' or 'data' are NULL, or if growing the heap fails - the heap is then unchanged. */
+gds_err gds_heap_push(GDSHeap* heap, const void* data, size_t* out_handle);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Adds copies of 'count' elements, stored contiguously at 'data'. If the count of added elements is large compared
+ * to the count of elements already in the heap, the whole heap is rebuilt in O(n) time instead of sifting up each
+ * element. If the heap is indexed and 'out_handles' is not NULL, the handle of element i is stored into
+ * 'out_handles'[i].
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_HEAP_ERR_REALLOC_FAIL.
+ * Function may fail if 'heap' or 'data' are NULL, or if growing the heap fails - the heap is then unchanged. */
+gds_err gds_heap_push_n(GDSHeap* heap, const void* data, size_t count, size_t* out_handles);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Replaces the contents of the heap with copies of the elements of 'vector' and arranges them into a heap in O(n)
+ * time. If the heap is indexed, element i of 'vector' gets handle i.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_GEN_ERR_INCONSISTENT_ARGS or
+ * GDS_HEAP_ERR_REALLOC_FAIL. Function may fail if 'heap' or 'vector' are NULL, if the element sizes of the heap and
+ * the vector differ, or if growing the heap fails - the heap is then empty. */
+gds_err gds_heap_heapify(GDSHeap* heap, const GDSVector* vector);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the top element. The address is valid until the heap is modified.
+ * Return value:
+ * on success - address of the top element,
+ * on failure - NULL. Function may fail if 'heap' is NULL or if the heap is empty. */
+void* gds_heap_top(const GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the top element. If 'out_data' is not NULL, the element is copied into it first.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_HEAP_ERR_HEAP_EMPTY. */
+gds_err gds_heap_pop(GDSHeap* heap, void* out_data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pushes the element pointed to by 'data' and then pops the top element into 'out_data', in a single sift. If the
+ * pushed element would be the new top, it is copied straight into 'out_data' and the heap isn't touched. This is the
+ * operation top-k queries need: keeping the k largest elements in a min-heap of size k. 'data' and 'out_data' may
+ * point to the same memory.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_HEAP_ERR_INDEXED.
+ * Function may fail if any of the arguments are NULL, or if the heap is indexed - the pushed element may never get a
+ * handle. */
+gds_err gds_heap_push_pop(GDSHeap* heap, const void* data, void* out_data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element with handle 'handle'. The address is valid until the heap is modified.
+ * Return value:
+ * on success - address of the element,
+ * on failure - NULL. Function may fail if 'heap' is NULL, if the heap isn't indexed or if 'handle' doesn't belong
+ * to an element in the heap. */
+void* gds_heap_at_handle(const GDSHeap* heap, size_t handle);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if 'handle' belongs to an element in the heap. Returns false if 'heap' is NULL or if it isn't indexed. */
+bool gds_heap_contains(const GDSHeap* heap, size_t handle);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Replaces the element with handle 'handle' with a copy of the element pointed to by 'data' and restores the heap
+ * order in O(log n) time. Usually the new element comes before the old one(decrease-key of a min-heap) and is moved
+ * up. If it comes after the old one, it is moved down instead, so the function also works as increase-key.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_HEAP_ERR_NOT_INDEXED or
+ * GDS_HEAP_ERR_INVALID_HANDLE. */
+gds_err gds_heap_decrease_key(GDSHeap* heap, size_t handle, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the element with handle 'handle'. If 'out_data' is not NULL, the element is copied into it first.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_HEAP_ERR_NOT_INDEXED or
+ * GDS_HEAP_ERR_INVALID_HANDLE. */
+gds_err gds_heap_remove(GDSHeap* heap, size_t handle, void* out_data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes all elements. The capacity is kept. For indexed heaps, all handles become invalid.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('heap' is NULL). */
+gds_err gds_heap_empty(GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current count of elements. Assumes non-NULL argument. */
+size_t gds_heap_get_count(const GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the heap is empty. Assumes non-NULL argument. */
+bool gds_heap_is_empty(const GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the size of each element. Assumes non-NULL argument. */
+size_t gds_heap_get_element_size(const GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the count of children of each node. Assumes non-NULL argument. */
+size_t gds_heap_get_arity(const GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the heap is indexed. Assumes non-NULL argument. */
+bool gds_heap_is_indexed(const GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSHeap) and returns the value. */
+size_t gds_heap_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_HEAP_H_
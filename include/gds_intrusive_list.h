@@ -0,0 +1,175 @@
+#ifndef _GDS_INTRUSIVE_LIST_H_
+#define _GDS_INTRUSIVE_LIST_H_
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSIntrusiveList;
+#else
+#define __GDS_INTRUSIVE_LIST_DEF_ALLOW__
+#include "def/gds_intrusive_list_def.h"
+#endif
+
+/* Link embedded by the user into their own struct. Unlike the list, the node is never opaque - the user allocates it
+ * as part of their object. While the node is linked, 'next' is managed by the list. */
+struct GDSIntrusiveListNode
+{
+    struct GDSIntrusiveListNode* next;
+};
+
+typedef struct GDSIntrusiveList GDSIntrusiveList;
+typedef struct GDSIntrusiveListNode GDSIntrusiveListNode;
+
+/* GDSIntrusiveList is a singly linked list of nodes embedded in the user's objects. The list only links the nodes - it
+ * never allocates, frees or copies anything, so an object that already lives in a pool or an array can be linked
+ * without a copy and without an allocation per link. The user owns the objects: they must stay alive while linked,
+ * and removing them from the list doesn't free them. An object can be in one list per embedded node.
+ * GDS_CONTAINER_OF() gets the address of the object from the address of its node. For example:
+ *
+ * struct Task { int id; GDSIntrusiveListNode link; };
+ * ...
+ * gds_intrusive_list_push_back(list, &task->link);
+ * ...
+ * GDS_INTRUSIVE_LIST_FOR_EACH(list, it)
+ * {
+ *     struct Task* task = GDS_CONTAINER_OF(it, struct Task, link);
+ * } */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Evaluates to the address of the struct of type 'type' whose member 'member' is at address 'ptr'. */
+#define GDS_CONTAINER_OF(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+
+/* Declares 'it' as a GDSIntrusiveListNode* and iterates it over the nodes of 'list', from the front. The list must not
+ * be modified during the iteration, except for unlinking nodes after 'it'. */
+#define GDS_INTRUSIVE_LIST_FOR_EACH(list, it)                                                                       \
+    for(GDSIntrusiveListNode* it = gds_intrusive_list_front(list); it != NULL; it = it->next)
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_INTRLIST_ERR_BASE 2500
+#define GDS_INTRLIST_ERR_NODE_NOT_FOUND 2501
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes 'list' as an empty list. This function is to be used only on uninitialized lists
+ * (gds_intrusive_list_create initializes the list). It may also be used after gds_intrusive_list_destruct().
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL). */
+gds_err gds_intrusive_list_init(GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for a GDSIntrusiveList. Performs a call to gds_intrusive_list_init() to initialize it.
+ * Return value:
+ * on success: address of newly allocated GDSIntrusiveList,
+ * on failure: NULL. Function may fail if the memory allocation for the list failed. */
+GDSIntrusiveList* gds_intrusive_list_create();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Used as a destructor. Unlinks all nodes from the list, the same way gds_intrusive_list_empty() does. If 'list' is
+ * NULL, function performs nothing. This doesn't free memory pointed to by 'list'. */
+void gds_intrusive_list_destruct(GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Links 'node' at the end of the list, in O(1) complexity. 'node' must not be linked in any list.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'node' are NULL). */
+gds_err gds_intrusive_list_push_back(GDSIntrusiveList* list, GDSIntrusiveListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Links 'node' at the start of the list, in O(1) complexity. 'node' must not be linked in any list.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'node' are NULL). */
+gds_err gds_intrusive_list_push_front(GDSIntrusiveList* list, GDSIntrusiveListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Links 'node' right after 'pos', in O(1) complexity. 'pos' must be linked in 'list' and 'node' must not be linked in
+ * any list.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list', 'pos' or 'node' are NULL). */
+gds_err gds_intrusive_list_insert_after(GDSIntrusiveList* list, GDSIntrusiveListNode* pos, GDSIntrusiveListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks the first node of the list, in O(1) complexity.
+ * Return value:
+ * on success: address of the unlinked node,
+ * on failure: NULL. Function may fail if 'list' is NULL or if the list is empty. */
+GDSIntrusiveListNode* gds_intrusive_list_pop_front(GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks the node right after 'pos', in O(1) complexity. 'pos' must be linked in 'list'.
+ * Return value:
+ * on success: address of the unlinked node,
+ * on failure: NULL. Function may fail if 'list' or 'pos' are NULL, or if 'pos' is the last node of the list. */
+GDSIntrusiveListNode* gds_intrusive_list_remove_after(GDSIntrusiveList* list, GDSIntrusiveListNode* pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks 'node' from the list. The list is singly linked, so the node before 'node' has to be found first - this is
+ * done in O(n) complexity. Prefer gds_intrusive_list_remove_after() when the previous node is known.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'node' are NULL) or
+ * GDS_INTRLIST_ERR_NODE_NOT_FOUND(if 'node' isn't linked in 'list'). */
+gds_err gds_intrusive_list_remove(GDSIntrusiveList* list, GDSIntrusiveListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves all nodes of 'src' to the end of 'dest', in O(1) complexity. After the call, 'src' is empty.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_GEN_ERR_INCONSISTENT_ARGS(if
+ * 'dest' and 'src' are the same list). */
+gds_err gds_intrusive_list_splice_back(GDSIntrusiveList* dest, GDSIntrusiveList* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks all nodes from the list, in O(1) complexity. The 'next' fields of the unlinked nodes are left as they are.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL). */
+gds_err gds_intrusive_list_empty(GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the first node of the list, or NULL if the list is empty. Function assumes non-NULL 'list' argument. */
+GDSIntrusiveListNode* gds_intrusive_list_front(const GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the last node of the list, or NULL if the list is empty. Function assumes non-NULL 'list' argument. */
+GDSIntrusiveListNode* gds_intrusive_list_back(const GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves list->_count. This function assumes a non-NULL 'list' argument */
+size_t gds_intrusive_list_get_count(const GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the intrusive list is empty. This function assumes a non-NULL 'list' argument. */
+bool gds_intrusive_list_is_empty(const GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSIntrusiveList) and returns the value. */
+size_t gds_intrusive_list_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_INTRUSIVE_LIST_H_
@@ -0,0 +1,345 @@
+#ifndef _GDS_LIST_H_
+#define _GDS_LIST_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+#include "gds_slab.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSList;
+struct GDSListIterator;
+#else
+#define __GDS_LIST_DEF_ALLOW__
+#include "def/gds_list_def.h"
+#endif
+
+typedef struct GDSList GDSList;
+typedef struct GDSListIterator GDSListIterator;
+
+/* GDSList is a doubly linked list. The API mirrors GDSForwardList, and so does node allocation: nodes come from the
+ * list's own GDSSlab pool, or from a pool shared by several lists(gds_list_init_shared()).
+ * Elements never move in memory while they are in the list, so the address of an element(returned by gds_list_at(),
+ * gds_list_front(), gds_list_back() or an iterator) can be kept as a handle to it. Through a handle, an element can
+ * be removed or moved to either end of the list in O(1) complexity, without searching for it - for example, to
+ * keep an LRU order or to cancel a timer. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_LIST_ERR_BASE 2200
+#define GDS_LIST_ERR_LIST_EMPTY 2201
+#define GDS_LIST_ERR_MALLOC_FAIL 2202
+
+#define GDS_LIST_ITER_ERR_OUT_OF_BOUNDS 2203
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes 'list' by setting values for its fields. This function is to be used only on uninitialized lists
+ * (gds_list_create initializes the list). It may also be used after gds_list_destruct().
+ * data_size must be greater than 0. _on_element_removal_func may be NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments. */
+gds_err gds_list_init(GDSList* list, size_t data_size, void (*_on_element_removal_func)(void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Initializes 'list' like gds_list_init(), but nodes are allocated from 'slab', which may be shared by other lists.
+ * The slab's object size must be at least gds_list_get_node_size('data_size'). The slab must outlive the list -
+ * destructing the list returns its nodes to the slab, but doesn't destruct it.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_GEN_ERR_INCONSISTENT_ARGS(if the
+ * slab's objects are too small). */
+gds_err gds_list_init_shared(GDSList* list, size_t data_size, void (*_on_element_removal_func)(void*), GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for a GDSList. Performs a call to gds_list_init() to initialize it.
+ * Return value:
+ * on success: address of newly allocated GDSList,
+ * on failure: NULL.
+ * Function may fail if the memory allocation for the list failed, or if gds_list_init() failed. */
+GDSList* gds_list_create(size_t data_size, void (*_on_element_removal_func)(void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as gds_list_create(), but performs a call to gds_list_init_shared(). */
+GDSList* gds_list_create_shared(size_t data_size, void (*_on_element_removal_func)(void*), GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Used as a destructor. Sets values of 'list' fields to default values.
+ * Removes all elements from the list(invocations of list->_on_element_removal_func will be made). If the list has its
+ * own node pool, the pool's memory is released in bulk.
+ * If 'list' is NULL, function performs nothing. This doesn't free memory pointed to by 'list'. */
+void gds_list_destruct(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves address of element with index 'pos' inside the list. The list is walked from whichever end is closer to
+ * 'pos', so the complexity is O(min(pos, count - pos)).
+ * Return value:
+ * on success: address of element with index 'pos',
+ * on failure: NULL. Function may fail if provided 'list' argument is NULL or if 'pos' is out of bounds. */
+void* gds_list_at(const GDSList* list, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves address of the first element of the list, in O(1) complexity.
+ * Return value:
+ * on success: address of the first element,
+ * on failure: NULL. Function may fail if 'list' is NULL or if the list is empty. */
+void* gds_list_front(const GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves address of the last element of the list, in O(1) complexity.
+ * Return value:
+ * on success: address of the last element,
+ * on failure: NULL. Function may fail if 'list' is NULL or if the list is empty. */
+void* gds_list_back(const GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Assigns data pointed to by 'data' to element with index 'pos' inside the list. This is done via memcpy().
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments.
+ * Function may fail if 'list' or 'data' are NULL or if 'pos' is out of bounds. */
+gds_err gds_list_assign(GDSList* list, const void* data, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions swaps data of elements with indices 'pos1' and 'pos2'. Function performs no action if pos1 == pos2.
+ * Make sure that swap_buff is of at least list->data_size size.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments.
+ * Function may fail if 'list' or 'swap_buff' are NULL or 'pos1' or 'pos2' are out of bounds. */
+gds_err gds_list_swap(GDSList* list, size_t pos1, size_t pos2, void* swap_buff);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions appends a new element at the end of a list in O(1) complexity.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list' or 'data' are NULL, or if dynamic allocation of a new node fails. */
+gds_err gds_list_push_back(GDSList* list, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions appends a new element at the start of a list in O(1) complexity.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list' or 'data' are NULL, or if dynamic allocation of a new node fails. */
+gds_err gds_list_push_front(GDSList* list, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions inserts a new element at index 'pos' in the list. Finding the position has the same complexity as
+ * gds_list_at().
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list' or 'data' are NULL, or if dynamic allocation of a new node fails. The
+ * function may also fail if 'pos' is out of bounds. */
+gds_err gds_list_insert_at(GDSList* list, const void* data, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function inserts a new element right before the element 'iterator' points at, in O(1) complexity. 'iterator' must
+ * belong to 'list'. The iterator keeps pointing at the same element, whose position grows by one.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list', 'iterator' or 'data' are NULL, or if dynamic allocation of the new node fails. */
+gds_err gds_list_insert_before(GDSList* list, GDSListIterator* iterator, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function inserts a new element right after the element 'iterator' points at, in O(1) complexity. 'iterator' must
+ * belong to 'list'. The iterator keeps pointing at the same element.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list', 'iterator' or 'data' are NULL, or if dynamic allocation of the new node fails. */
+gds_err gds_list_insert_after(GDSList* list, GDSListIterator* iterator, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes an element from the start of the list.
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL)
+ * or GDS_LIST_ERR_LIST_EMPTY. */
+gds_err gds_list_pop_front(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes an element from the end of the list.
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL)
+ * or GDS_LIST_ERR_LIST_EMPTY. */
+gds_err gds_list_pop_back(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes an element with index 'pos' from the list. Finding the element has the same complexity as
+ * gds_list_at().
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL or if 'pos' is out
+ * of bounds). */
+gds_err gds_list_remove_at(GDSList* list, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes the element at address 'element', in O(1) complexity. 'element' must be the address of an element
+ * of 'list' - a handle retrieved from the list earlier. Other handles stay valid.
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'element' are NULL). */
+gds_err gds_list_remove(GDSList* list, void* element);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes the element 'iterator' points at, in O(1) complexity. 'iterator' must belong to 'list'. The
+ * iterator moves to the following element, which takes over the position of the removed one. If the removed element
+ * was the last one, the iterator points at no element afterwards and must be initialized again before further use.
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'iterator' are NULL).
+ * Function may also return GDS_FAILURE if the iterator points at no element. */
+gds_err gds_list_erase(GDSList* list, GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function moves the element at address 'element' to the start of the list, in O(1) complexity. 'element' must be
+ * the address of an element of 'list'. The element isn't copied, so its address stays the same.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'element' are NULL). */
+gds_err gds_list_move_to_front(GDSList* list, void* element);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as gds_list_move_to_front(), but the element is moved to the end of the list. */
+gds_err gds_list_move_to_back(GDSList* list, void* element);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function empties the list.
+ * This function will invoke list->_on_element_removal_func for each removed element, if non-NULL. If the list has its
+ * own node pool, all nodes are released at once and the pool's memory is returned to the system.
+ * If the list is already empty, the function performs no action and returns GDS_SUCCESS.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL). */
+gds_err gds_list_empty(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves list->_data_size. This function assumes a non-NULL 'list' argument */
+size_t gds_list_get_data_size(const GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves list->_count. This function assumes a non-NULL 'list' argument */
+size_t gds_list_get_count(const GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the list is empty. This function assumes a non-NULL 'list' argument. */
+bool gds_list_is_empty(const GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the size of one list node holding data of size 'data_size' - the object size a slab shared by such lists
+ * must have. */
+size_t gds_list_get_node_size(size_t data_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSList) and returns the value. */
+size_t gds_list_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the GDSList iterator. The iterator will point at the first element of the list.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'iterator' is NULL.)
+ * or GDS_LIST_ERR_LIST_EMPTY. */
+gds_err gds_list_iterator_init(GDSList* list, GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as gds_list_iterator_init(), but the iterator will point at the last element of the list, for iterating in
+ * reverse with gds_list_iterator_prev(). */
+gds_err gds_list_iterator_init_back(GDSList* list, GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for the iterator and invokes gds_list_iterator_init() to initialize it.
+ * The caller is responsible for freeing the dynamically allocated memory for the GDSListIterator after using it.
+ * Return value:
+ * on success: address of the newly allocated GDSListIterator,
+ * on failure: NULL.
+ * Function may fail if 'list' is NULL, allocation for GDSListIterator fails, or if the call to
+ * gds_list_iterator_init() function fails. */
+GDSListIterator* gds_list_iterator_create(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves iterator to the next element.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ITER_ERR_OUT_OF_BOUNDS.
+ * Function may fail if 'iterator' is NULL or the iterator is at the end of the list.
+ * Function may also return GDS_FAILURE if the iterator points at no element. */
+gds_err gds_list_iterator_next(GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves iterator to the previous element.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_LIST_ITER_ERR_OUT_OF_BOUNDS.
+ * Function may fail if 'iterator' is NULL or the iterator is at the start of the list.
+ * Function may also return GDS_FAILURE if the iterator points at no element. */
+gds_err gds_list_iterator_prev(GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the iterator has a next element to move to. Function assumes non-NULL 'iterator' */
+bool gds_list_iterator_has_next(GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the iterator has a previous element to move to. Function assumes non-NULL 'iterator' */
+bool gds_list_iterator_has_prev(GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the data of the element the iterator is pointing at, or NULL if it points at no element. Function assumes
+ * non-NULL 'iterator' */
+void* gds_list_iterator_get_data(GDSListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the position of the element the iterator is pointing at. Function assumes non-NULL 'iterator' */
+size_t gds_list_iterator_get_pos(GDSListIterator* iterator);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_LIST_H_
@@ -0,0 +1,101 @@
+#ifndef _GDS_LOCKFREE_STACK_H_
+#define _GDS_LOCKFREE_STACK_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+#include "gds_intrusive_list.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSLockFreeStack;
+#else
+#define __GDS_LOCKFREE_STACK_DEF_ALLOW__
+#include "def/gds_lockfree_stack_def.h"
+#endif
+
+typedef struct GDSLockFreeStack GDSLockFreeStack;
+
+/* GDSLockFreeStack is a lock-free, intrusive LIFO stack(Treiber stack) of GDSIntrusiveListNode nodes embedded in the
+ * user's objects. Any number of threads may push and pop concurrently. The stack never allocates - like with
+ * GDSIntrusiveList, the user owns the objects and gets back to them with GDS_CONTAINER_OF().
+ * The top of the stack is paired with a tag and both are updated by one double-width compare-and-swap(cmpxchg16b on
+ * x86-64). This protects gds_lockfree_stack_pop() from the ABA problem: a node that was popped and pushed back while
+ * another thread was popping it doesn't corrupt the stack.
+ * A thread in gds_lockfree_stack_pop() may still read the 'next' field of a node that was popped by another thread
+ * a moment ago. The memory of popped nodes must therefore stay readable while the stack is in use - nodes should
+ * live in pools, slabs or arrays, not be free()'d right after popping.
+ * Because the struct is cache-line aligned, a stack that isn't created by gds_lockfree_stack_create() must be placed
+ * in memory aligned to GDS_CACHE_LINE_SIZE. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the stack as empty. Not thread-safe.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if 'stack' is NULL). */
+gds_err gds_lockfree_stack_init(GDSLockFreeStack* stack);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates cache-line aligned memory for GDSLockFreeStack. Calls gds_lockfree_stack_init() to
+ * initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSLockFreeStack,
+ * on failure - NULL. The function can fail if allocating memory for the new stack failed. */
+GDSLockFreeStack* gds_lockfree_stack_create();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks all nodes from the stack. Not thread-safe - no thread may use the stack anymore. If 'stack' is NULL, the
+ * function performs no action. This doesn't free memory pointed to by 'stack'. */
+void gds_lockfree_stack_destruct(GDSLockFreeStack* stack);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pushes 'node' on top of the stack. 'node' must not be linked in any list or stack.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if 'stack' or 'node' are NULL). */
+gds_err gds_lockfree_stack_push(GDSLockFreeStack* stack, GDSIntrusiveListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pushes all nodes of 'list' with a single compare-and-swap, so they are never interleaved with nodes pushed by other
+ * threads. The front of 'list' becomes the top of the stack. After the call, 'list' is empty. 'list' must not be
+ * used by other threads.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if 'stack' or 'list' are NULL). */
+gds_err gds_lockfree_stack_push_list(GDSLockFreeStack* stack, GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pops the node on top of the stack.
+ * Return value:
+ * on success - address of the popped node,
+ * on failure - NULL. Function may fail if 'stack' is NULL or if the stack is empty. */
+GDSIntrusiveListNode* gds_lockfree_stack_pop(GDSLockFreeStack* stack);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pops all nodes of the stack at once and appends them to the end of 'out', from the top of the stack down. Unlike
+ * popping one by one, this takes a single compare-and-swap no matter how many nodes are popped. 'out' must not be
+ * used by other threads.
+ * Return value: the count of popped nodes. 0 if the stack is empty or if 'stack' or 'out' are NULL. */
+size_t gds_lockfree_stack_pop_all(GDSLockFreeStack* stack, GDSIntrusiveList* out);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the stack is empty. The result may be stale when returned, as other threads may be active. Assumes
+ * non-NULL argument. */
+bool gds_lockfree_stack_is_empty(const GDSLockFreeStack* stack);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSLockFreeStack) and returns the value. */
+size_t gds_lockfree_stack_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_LOCKFREE_STACK_H_
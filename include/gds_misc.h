@@ -3,6 +3,8 @@
 
 #include "gds.h"
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 
 int gds_misc_max(ssize_t x, ssize_t y);
 int gds_misc_min(ssize_t x, ssize_t y);
@@ -10,4 +12,64 @@ void gds_misc_swap(void* data1, void* data2, void* swap_buff, size_t data_size);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Swaps 'data_size' bytes pointed to by 'data1' and 'data2' without the need for a caller-provided buffer.
+ * Common element sizes(1, 2, 4, 8 and 16 bytes) are swapped through registers. Other sizes are swapped in 8-byte
+ * words, followed by the remaining bytes. The memory regions must not overlap. The fixed-size memcpy() calls are
+ * compiled into plain loads and stores, so this does not depend on the alignment of 'data1' and 'data2'. */
+static inline void gds_misc_swap_inplace(void* data1, void* data2, size_t data_size)
+{
+    unsigned char* d1 = (unsigned char*)data1;
+    unsigned char* d2 = (unsigned char*)data2;
+    uint64_t w1, w2, w3, w4;
+
+    switch(data_size)
+    {
+        case 1:
+            w1 = d1[0]; d1[0] = d2[0]; d2[0] = (unsigned char)w1;
+            return;
+        case 2:
+        {
+            uint16_t h1, h2;
+            memcpy(&h1, d1, 2); memcpy(&h2, d2, 2);
+            memcpy(d1, &h2, 2); memcpy(d2, &h1, 2);
+            return;
+        }
+        case 4:
+        {
+            uint32_t h1, h2;
+            memcpy(&h1, d1, 4); memcpy(&h2, d2, 4);
+            memcpy(d1, &h2, 4); memcpy(d2, &h1, 4);
+            return;
+        }
+        case 8:
+            memcpy(&w1, d1, 8); memcpy(&w2, d2, 8);
+            memcpy(d1, &w2, 8); memcpy(d2, &w1, 8);
+            return;
+        case 16:
+            memcpy(&w1, d1, 8); memcpy(&w2, d1 + 8, 8);
+            memcpy(&w3, d2, 8); memcpy(&w4, d2 + 8, 8);
+            memcpy(d1, &w3, 8); memcpy(d1 + 8, &w4, 8);
+            memcpy(d2, &w1, 8); memcpy(d2 + 8, &w2, 8);
+            return;
+        default:
+            break;
+    }
+
+    while(data_size >= 8)
+    {
+        memcpy(&w1, d1, 8); memcpy(&w2, d2, 8);
+        memcpy(d1, &w2, 8); memcpy(d2, &w1, 8);
+        d1 += 8; d2 += 8; data_size -= 8;
+    }
+
+    unsigned char b;
+    while(data_size > 0)
+    {
+        b = *d1; *d1 = *d2; *d2 = b;
+        d1++; d2++; data_size--;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 #endif
@@ -0,0 +1,114 @@
+#ifndef _GDS_MPMC_QUEUE_H_
+#define _GDS_MPMC_QUEUE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSMPMCQueue;
+#else
+#define __GDS_MPMC_QUEUE_DEF_ALLOW__
+#include "def/gds_mpmc_queue_def.h"
+#endif
+
+typedef struct GDSMPMCQueue GDSMPMCQueue;
+
+/* GDSMPMCQueue is a bounded, lock-free, multi-producer/multi-consumer FIFO queue of fixed-size elements(Dmitry
+ * Vyukov's bounded MPMC queue). Each of the 'capacity' cells holds a sequence number next to the element. The
+ * sequence number tells whether the cell is ready to be written for a given position, or ready to be read. Producers
+ * and consumers claim positions with a single compare-and-swap each, and only ever wait on the cell they claimed.
+ * Any number of threads may enqueue and dequeue concurrently.
+ * Because the struct is cache-line aligned, a queue that isn't created by gds_mpmc_queue_create() must be
+ * placed in memory aligned to GDS_CACHE_LINE_SIZE. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_MPMC_ERR_BASE 510
+#define GDS_MPMC_ERR_QUEUE_FULL 511
+#define GDS_MPMC_ERR_QUEUE_EMPTY 512
+#define GDS_MPMC_ERR_MALLOC_FAIL 513
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the queue, so it can hold 'capacity' elements(rounded up to a power of two, at least 2).
+ * Not thread-safe.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_MPMC_ERR_MALLOC_FAIL.
+ * Function may fail if 'queue' is NULL, 'element_size' == 0 or 'capacity' == 0. */
+gds_err gds_mpmc_queue_init(GDSMPMCQueue* queue, size_t element_size, size_t capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates cache-line aligned memory for GDSMPMCQueue. Calls gds_mpmc_queue_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSMPMCQueue,
+ * on failure - NULL. The function can fail because: allocating memory for the new queue failed, or because
+ * gds_mpmc_queue_init() returned an error code. */
+GDSMPMCQueue* gds_mpmc_queue_create(size_t element_size, size_t capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the queue. Not thread-safe - no thread may use the queue anymore.
+ * If 'queue' is NULL, the function performs no action. This doesn't free memory pointed to by 'queue'. */
+void gds_mpmc_queue_destruct(GDSMPMCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the element pointed to by 'data' into the queue.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_MPMC_ERR_QUEUE_FULL.
+ * Function may fail if 'queue' or 'data' are NULL, or if the queue is full. */
+gds_err gds_mpmc_queue_enqueue(GDSMPMCQueue* queue, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the oldest element of the queue into 'out' and removes it.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_MPMC_ERR_QUEUE_EMPTY.
+ * Function may fail if 'queue' or 'out' are NULL, or if the queue is empty. */
+gds_err gds_mpmc_queue_dequeue(GDSMPMCQueue* queue, void* out);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Enqueues up to 'count' elements stored contiguously at 'data'. A run of consecutive free cells is claimed with a
+ * single compare-and-swap, so the elements of one call are never interleaved with elements of other producers.
+ * Return value: the number of enqueued elements(the first ones from 'data'). 0 if the queue is full or if 'queue'
+ * or 'data' are NULL. */
+size_t gds_mpmc_queue_enqueue_n(GDSMPMCQueue* queue, const void* data, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dequeues up to 'max_count' elements into 'out'. A run of consecutive ready cells is claimed with a single
+ * compare-and-swap.
+ * Return value: the number of dequeued elements. 0 if the queue is empty or if 'queue' or 'out' are NULL. */
+size_t gds_mpmc_queue_dequeue_n(GDSMPMCQueue* queue, void* out, size_t max_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the approximate count of elements in the queue - it may be stale when returned, as other threads may be
+ * active. Assumes non-NULL argument. */
+size_t gds_mpmc_queue_get_count(const GDSMPMCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the capacity of the queue. Assumes non-NULL argument. */
+size_t gds_mpmc_queue_get_capacity(const GDSMPMCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns element size of the queue. Assumes non-NULL argument. */
+size_t gds_mpmc_queue_get_element_size(const GDSMPMCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSMPMCQueue) and returns the value. */
+size_t gds_mpmc_queue_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_MPMC_QUEUE_H_
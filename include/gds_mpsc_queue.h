@@ -0,0 +1,99 @@
+#ifndef _GDS_MPSC_QUEUE_H_
+#define _GDS_MPSC_QUEUE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+#include "gds_intrusive_list.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSMPSCQueue;
+#else
+#define __GDS_MPSC_QUEUE_DEF_ALLOW__
+#include "def/gds_mpsc_queue_def.h"
+#endif
+
+typedef struct GDSMPSCQueue GDSMPSCQueue;
+
+/* GDSMPSCQueue is an unbounded, intrusive, multi-producer/single-consumer FIFO queue(Dmitry Vyukov's intrusive MPSC
+ * queue) of GDSIntrusiveListNode nodes embedded in the user's objects. A push is a single atomic exchange and never
+ * fails or waits, no matter how many producers there are. Only one thread at a time may pop. The queue never
+ * allocates - the user owns the objects and gets back to them with GDS_CONTAINER_OF().
+ * A producer that was preempted between its exchange and linking its node briefly hides the nodes pushed after it:
+ * gds_mpsc_queue_pop() returns NULL until the producer continues, even if the queue isn't empty.
+ * The queue holds a placeholder node that points into the struct itself, so an initialized queue must not be moved
+ * or copied. Because the struct is cache-line aligned, a queue that isn't created by gds_mpsc_queue_create() must
+ * be placed in memory aligned to GDS_CACHE_LINE_SIZE. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the queue as empty. Not thread-safe.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if 'queue' is NULL). */
+gds_err gds_mpsc_queue_init(GDSMPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates cache-line aligned memory for GDSMPSCQueue. Calls gds_mpsc_queue_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSMPSCQueue,
+ * on failure - NULL. The function can fail if allocating memory for the new queue failed. */
+GDSMPSCQueue* gds_mpsc_queue_create();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks all nodes from the queue. Not thread-safe - no thread may use the queue anymore. If 'queue' is NULL, the
+ * function performs no action. This doesn't free memory pointed to by 'queue'. */
+void gds_mpsc_queue_destruct(GDSMPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pushes 'node' to the back of the queue. May be called by any number of threads concurrently. 'node' must not be
+ * linked in any list or queue.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if 'queue' or 'node' are NULL). */
+gds_err gds_mpsc_queue_push(GDSMPSCQueue* queue, GDSIntrusiveListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pushes all nodes of 'list' to the back of the queue with a single atomic exchange, so they are never interleaved
+ * with nodes pushed by other threads. The order of the nodes is kept. After the call, 'list' is empty. 'list' must
+ * not be used by other threads.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument(if 'queue' or 'list' are NULL). */
+gds_err gds_mpsc_queue_push_list(GDSMPSCQueue* queue, GDSIntrusiveList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pops the oldest node of the queue. Must be called only by the consumer thread.
+ * Return value:
+ * on success - address of the popped node,
+ * on failure - NULL. Function may fail if 'queue' is NULL, if the queue is empty or if the next node is still being
+ * linked by a producer. */
+GDSIntrusiveListNode* gds_mpsc_queue_pop(GDSMPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pops all nodes that can be popped and appends them to the end of 'out', oldest first. Must be called only by the
+ * consumer thread.
+ * Return value: the count of popped nodes. 0 if nothing could be popped or if 'queue' or 'out' are NULL. */
+size_t gds_mpsc_queue_pop_all(GDSMPSCQueue* queue, GDSIntrusiveList* out);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the queue is empty. Must be called only by the consumer thread - the result may then be stale only in the
+ * direction of nodes being pushed meanwhile. Assumes non-NULL argument. */
+bool gds_mpsc_queue_is_empty(const GDSMPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSMPSCQueue) and returns the value. */
+size_t gds_mpsc_queue_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_MPSC_QUEUE_H_
@@ -0,0 +1,183 @@
+#ifndef _GDS_PARALLEL_H_
+#define _GDS_PARALLEL_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_vector.h"
+#include "gds_pool.h"
+
+/* Parallel algorithms over GDSArray and GDSVector. The elements are split into chunks of about GDS_PAR_CHUNK_BYTES
+ * bytes. The count of elements in a chunk is chosen so that a chunk takes up a whole number of cache lines - threads
+ * working on neighbouring chunks of a cache-line aligned buffer never write to the same cache line. Chunks are handed
+ * out to the worker threads dynamically, and the calling thread works on chunks as well.
+ * Chunk boundaries depend only on the count and size of the elements - not on the count of threads. Reductions and
+ * scans combine per-chunk results in chunk order, so their results(including rounding of floating point
+ * operations) are the same for any count of threads, as long as the passed operations are associative.
+ * Callbacks are called concurrently from multiple threads and must be safe to call that way. Arrays of at most one
+ * chunk are processed by the calling thread alone.
+ * By default, threads are started for each call. If a pool is set with gds_parallel_set_pool(), the work is submitted
+ * to the pool instead, and the algorithms may then also be called from tasks of that pool. */
+
+#ifndef GDS_PAR_CHUNK_BYTES
+#define GDS_PAR_CHUNK_BYTES 65536
+#endif // GDS_PAR_CHUNK_BYTES
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_PAR_ERR_BASE 3100
+#define GDS_PAR_ERR_MALLOC_FAIL 3101
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Sets the count of threads(including the calling thread) the parallel algorithms use. If 'thread_count' == 0, the
+ * default count is used: the count of online processors, or the pool's count of workers plus one if a pool is set
+ * with gds_parallel_set_pool(). */
+void gds_parallel_set_thread_count(size_t thread_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of threads(including the calling thread) the parallel algorithms use. */
+size_t gds_parallel_get_thread_count();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Makes the parallel algorithms run their work on 'pool' instead of starting threads for each call. If 'pool' is NULL,
+ * the algorithms go back to starting threads. The pool must not be destructed while it is set. */
+void gds_parallel_set_pool(GDSPool* pool);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the pool set by gds_parallel_set_pool(), or NULL if none is set. */
+GDSPool* gds_parallel_get_pool();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls 'func' for each element of the array. The order of the calls is unspecified. 'ctx' is passed to each call.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'array' or 'func' are NULL. */
+gds_err gds_parallel_array_for_each(GDSArray* array, void (*func)(void* element, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* For each element of 'src', calls 'func' to compute the element at the same index of 'dest'. The count of 'dest'
+ * becomes the count of 'src'. Element sizes of the arrays may differ. 'src' and 'dest' may be the same array.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_GEN_ERR_INCONSISTENT_ARGS.
+ * Function may fail if 'src', 'dest' or 'func' are NULL, or if the capacity of 'dest' is less than the count of
+ * 'src'(GDS_GEN_ERR_INCONSISTENT_ARGS). */
+gds_err gds_parallel_array_transform(const GDSArray* src, GDSArray* dest,
+        void (*func)(const void* element, void* out, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reduces the array into 'result', which holds a value of 'result_size' bytes. Each chunk is reduced separately:
+ * a copy of 'identity' is made, and 'accumulate' folds the chunk's elements into it, in order. The per-chunk values
+ * are then folded into 'result'(also starting from 'identity') with 'combine', in chunk order. The result is
+ * deterministic - see the beginning of this file.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_PAR_ERR_MALLOC_FAIL.
+ * Function may fail if any of the pointer arguments except 'ctx' are NULL, if 'result_size' == 0, or if allocating
+ * memory for the per-chunk values fails. */
+gds_err gds_parallel_array_reduce(const GDSArray* array, void* result, size_t result_size, const void* identity,
+        void (*accumulate)(void* acc, const void* element, void* ctx),
+        void (*combine)(void* acc, const void* other, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Replaces each element with the combination of all elements up to and including it, in place. 'op' folds
+ * 'element' into 'acc' and must be associative. 'identity' must be the identity value of 'op'. The scan is done in
+ * three steps: the chunks are reduced in parallel, the chunk totals are scanned serially, and then each chunk is
+ * scanned in parallel, starting from the total of the preceding chunks.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_PAR_ERR_MALLOC_FAIL.
+ * Function may fail if 'array', 'identity' or 'op' are NULL, or if allocating memory for the per-chunk values
+ * fails. */
+gds_err gds_parallel_array_inclusive_scan(GDSArray* array, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as gds_parallel_array_inclusive_scan(), except that each element is replaced with the combination of all
+ * elements before it - the first element becomes 'identity'. */
+gds_err gds_parallel_array_exclusive_scan(GDSArray* array, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reorders the array so that the elements for which 'pred' returns true come before those for which it returns
+ * false. The relative order of elements inside both groups is preserved. 'pred' is called twice for each
+ * element(once to count, once to place the element), so it must return the same value for the same element.
+ * A temporary buffer of the array's size is allocated. If 'out_true_count' is not NULL, the count of elements for
+ * which 'pred' returned true is stored into it.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_PAR_ERR_MALLOC_FAIL.
+ * Function may fail if 'array' or 'pred' are NULL, or if allocating the temporary buffer fails. */
+gds_err gds_parallel_array_stable_partition(GDSArray* array, bool (*pred)(const void* element, void* ctx), void* ctx,
+        size_t* out_true_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sorts the array in ascending order, as defined by 'compare_func'(qsort() contract). The array is split into one
+ * run per thread, each run is sorted with gds_array_sort(), and runs are then merged pairwise. Each merge pass is
+ * split into chunks of the output, so all threads take part in every pass, including the last one. A temporary
+ * buffer of the array's size is allocated. The sort is not stable.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_PAR_ERR_MALLOC_FAIL.
+ * Function may fail if 'array' or 'compare_func' are NULL, or if allocating the temporary buffer fails. */
+gds_err gds_parallel_array_sort(GDSArray* array, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_for_each() for the vector's data. */
+gds_err gds_parallel_vector_for_each(GDSVector* vector, void (*func)(void* element, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_transform() for the vectors' data. If needed, 'dest' is first grown to fit the count of
+ * 'src' - so the function may also fail with GDS_VEC_ERR_REALLOC_FAIL. */
+gds_err gds_parallel_vector_transform(const GDSVector* src, GDSVector* dest,
+        void (*func)(const void* element, void* out, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_reduce() for the vector's data. */
+gds_err gds_parallel_vector_reduce(const GDSVector* vector, void* result, size_t result_size, const void* identity,
+        void (*accumulate)(void* acc, const void* element, void* ctx),
+        void (*combine)(void* acc, const void* other, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_inclusive_scan() for the vector's data. */
+gds_err gds_parallel_vector_inclusive_scan(GDSVector* vector, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_exclusive_scan() for the vector's data. */
+gds_err gds_parallel_vector_exclusive_scan(GDSVector* vector, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_stable_partition() for the vector's data. */
+gds_err gds_parallel_vector_stable_partition(GDSVector* vector, bool (*pred)(const void* element, void* ctx),
+        void* ctx, size_t* out_true_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_parallel_array_sort() for the vector's data. */
+gds_err gds_parallel_vector_sort(GDSVector* vector, int (*compare_func)(const void*, const void*));
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_PARALLEL_H_
@@ -0,0 +1,129 @@
+#ifndef _GDS_POOL_H_
+#define _GDS_POOL_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSPool;
+struct GDSPoolGroup;
+#else
+#define __GDS_POOL_DEF_ALLOW__
+#include "def/gds_pool_def.h"
+#endif
+
+typedef struct GDSPool GDSPool;
+typedef struct GDSPoolGroup GDSPoolGroup;
+
+/* GDSPool is a work-stealing thread pool. Each worker thread owns a Chase-Lev deque of tasks: tasks submitted from
+ * a worker(for example, from inside another task) are pushed to and popped from the bottom of its own deque, without
+ * any locking. Idle workers steal tasks from the top of other workers' deques. Tasks submitted from other threads go
+ * through a shared lock-free queue(GDSMPMCQueue). Workers with nothing to do sleep until new tasks are submitted.
+ * A task is a function and a context pointer. Tasks can be gathered into a GDSPoolGroup, whose tasks can be waited
+ * for - a thread waiting for a group runs queued tasks in the meantime, so groups may be waited for from inside tasks.
+ * If a worker's deque or the shared queue is full, the submitted task is run immediately by the submitting thread.
+ * The parallel algorithms(gds_parallel.h) can be told to schedule their work on a pool with gds_parallel_set_pool().
+ * Because the struct is cache-line aligned, a pool that isn't created by gds_pool_create() must be placed in memory
+ * aligned to GDS_CACHE_LINE_SIZE. */
+
+#define GDS_POOL_DEQUE_CAPACITY 4096
+#define GDS_POOL_QUEUE_CAPACITY 4096
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_POOL_ERR_BASE 3200
+#define GDS_POOL_ERR_MALLOC_FAIL 3201
+#define GDS_POOL_ERR_THREAD_FAIL 3202
+#define GDS_POOL_ERR_AFFINITY_FAIL 3203
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the pool and starts 'thread_count' worker threads. If 'thread_count' == 0, one worker per online
+ * processor is started. If 'cpus' is not NULL, it must hold 'thread_count' CPU indices, and worker i is pinned to CPU
+ * cpus[i](supported on Linux only). If 'cpus' is NULL, the workers are not pinned.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_POOL_ERR_MALLOC_FAIL,
+ * GDS_POOL_ERR_THREAD_FAIL or GDS_POOL_ERR_AFFINITY_FAIL. Function may fail if 'pool' is NULL, if 'cpus' is not NULL
+ * while 'thread_count' == 0(GDS_GEN_ERR_INCONSISTENT_ARGS), if an allocation fails, if a thread can't be started or
+ * if a worker can't be pinned to its CPU. On failure, the threads that were started are stopped. */
+gds_err gds_pool_init(GDSPool* pool, size_t thread_count, const int* cpus);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates cache-line aligned memory for GDSPool. Calls gds_pool_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSPool,
+ * on failure - NULL. The function can fail because: allocating memory for the new pool failed, or because
+ * gds_pool_init() returned an error code. */
+GDSPool* gds_pool_create(size_t thread_count, const int* cpus);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Stops the worker threads and frees dynamically allocated memory for the pool. Tasks that are still queued are run
+ * before the workers exit. Must not be called from a task of the pool. If 'pool' is NULL, the function performs no
+ * action. This doesn't free memory pointed to by 'pool'. */
+void gds_pool_destruct(GDSPool* pool);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Submits the task 'func'('ctx') to the pool. If 'group' is not NULL, the task is added to the group. Can be called
+ * from any thread, including from tasks of the pool.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'pool' or 'func' are NULL. */
+gds_err gds_pool_submit(GDSPool* pool, GDSPoolGroup* group, void (*func)(void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Waits until all tasks submitted to 'group' have finished. While waiting, the calling thread runs queued tasks of
+ * the pool, so this can be called from inside a task without blocking a worker. When there are no tasks left to
+ * run, the thread sleeps until the group's last task finishes.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'pool' or 'group' are NULL. */
+gds_err gds_pool_group_wait(GDSPool* pool, GDSPoolGroup* group);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of worker threads of the pool. Assumes non-NULL argument. */
+size_t gds_pool_get_thread_count(const GDSPool* pool);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSPool) and returns the value. */
+size_t gds_pool_get_struct_size();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Initializes an empty task group. A group may be reused after it has been waited for.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument('group' is NULL). */
+gds_err gds_pool_group_init(GDSPoolGroup* group);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSPoolGroup and initializes it with gds_pool_group_init().
+ * Return value:
+ * on success - address of dynamically allocated GDSPoolGroup,
+ * on failure - NULL. */
+GDSPoolGroup* gds_pool_group_create();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of tasks of the group that haven't finished yet. Assumes non-NULL argument. */
+size_t gds_pool_group_get_pending_count(const GDSPoolGroup* group);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSPoolGroup) and returns the value. */
+size_t gds_pool_group_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_POOL_H_
@@ -0,0 +1,185 @@
+#ifndef _GDS_SEGMENTED_VECTOR_H_
+#define _GDS_SEGMENTED_VECTOR_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSSegmentedVector;
+#else
+#define __GDS_SEGMENTED_VECTOR_DEF_ALLOW__
+#include "def/gds_segmented_vector_def.h"
+#endif
+
+typedef struct GDSSegmentedVector GDSSegmentedVector;
+
+/* GDSSegmentedVector is a growable sequence of elements stored in fixed-size segments. A directory(GDSVector) holds
+ * the addresses of the segments. Every segment holds the same, power of two, count of elements, so an element's
+ * position is split into a segment index and an offset with a shift and a mask. Growing allocates a new segment -
+ * elements are never moved, so addresses returned by gds_segmented_vector_at() stay valid until the element is
+ * removed or the vector is destructed. Only the directory of segment addresses is reallocated on growth.
+ * Elements are contiguous within a segment - gds_segmented_vector_get_segment() can be used for bulk access. */
+
+#define GDS_SEGVEC_DEFAULT_SEGMENT_BYTES 65536
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_SEGVEC_ERR_BASE 600
+#define GDS_SEGVEC_ERR_SEGVEC_EMPTY 601
+#define GDS_SEGVEC_ERR_MALLOC_FAIL 602
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the segmented vector. Used when opaque structs are disabled. May also be used for initializing a
+ * segmented vector after its destruction. Each segment will hold 'segment_capacity' elements, rounded up to a power
+ * of two. Segments are only allocated when needed.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SEGVEC_ERR_MALLOC_FAIL.
+ * Function may fail if 'segvec' is NULL, 'element_size' == 0 or 'segment_capacity' == 0. */
+gds_err gds_segmented_vector_init(GDSSegmentedVector* segvec, size_t element_size, size_t segment_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls gds_segmented_vector_init() with the segment capacity chosen so that a segment takes up about
+ * GDS_SEGVEC_DEFAULT_SEGMENT_BYTES bytes. */
+gds_err gds_segmented_vector_init_default(GDSSegmentedVector* segvec, size_t element_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSSegmentedVector. Calls gds_segmented_vector_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSSegmentedVector,
+ * on failure - NULL. The function can fail because: allocating memory for the new segmented vector failed, or because
+ * gds_segmented_vector_init() returned an error code. */
+GDSSegmentedVector* gds_segmented_vector_create(size_t element_size, size_t segment_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees all segments and the directory. If 'segvec' is NULL, the function performs no action. This doesn't free
+ * memory pointed to by 'segvec'. */
+void gds_segmented_vector_destruct(GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element at index 'pos'. The address stays valid until the element is removed.
+ * Return value:
+ * on success - address of the element,
+ * on failure - NULL. Function may fail if 'segvec' is NULL or if 'pos' is out of bounds. */
+void* gds_segmented_vector_at(const GDSSegmentedVector* segvec, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the element pointed to by 'data' into the element at index 'pos'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'segvec' or 'data' are NULL, or if 'pos' is out of bounds. */
+gds_err gds_segmented_vector_assign(GDSSegmentedVector* segvec, const void* data, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Appends the element pointed to by 'data'. If the last segment is full, a new segment is allocated - existing
+ * elements are not moved.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SEGVEC_ERR_MALLOC_FAIL.
+ * Function may fail if 'segvec' or 'data' are NULL, or if allocating a new segment(or growing the directory)
+ * fails. */
+gds_err gds_segmented_vector_push_back(GDSSegmentedVector* segvec, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Appends 'count' elements stored contiguously at 'data', copying as many elements per memcpy() call as fit in the
+ * current segment. Either all elements are appended or none are.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SEGVEC_ERR_MALLOC_FAIL.
+ * Function may fail if 'segvec' or 'data' are NULL, or if allocating the needed segments fails. */
+gds_err gds_segmented_vector_push_back_n(GDSSegmentedVector* segvec, const void* data, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the last element. The segment it was in is kept allocated.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SEGVEC_ERR_SEGVEC_EMPTY.
+ * Function may fail if 'segvec' is NULL or if it is empty. */
+gds_err gds_segmented_vector_pop_back(GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes all elements in O(1). Allocated segments are kept for reuse.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('segvec' is NULL). */
+gds_err gds_segmented_vector_empty(GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Allocates segments until the segmented vector can hold at least 'new_capacity' elements. Existing elements are
+ * not moved.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SEGVEC_ERR_MALLOC_FAIL.
+ * Function may fail if 'segvec' is NULL or if an allocation fails. Segments allocated before the failure are kept. */
+gds_err gds_segmented_vector_reserve(GDSSegmentedVector* segvec, size_t new_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees the segments that hold no elements. Existing elements are not moved.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('segvec' is NULL). */
+gds_err gds_segmented_vector_fit(GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the first element of segment 'segment_index' and stores the count of elements in that
+ * segment into 'out_count'. Iterating over segments 0 .. gds_segmented_vector_get_segment_count() - 1 visits all
+ * elements in order.
+ * Return value:
+ * on success - address of the segment's first element,
+ * on failure - NULL. Function may fail if 'segvec' or 'out_count' are NULL, or if the segment holds no elements. */
+void* gds_segmented_vector_get_segment(const GDSSegmentedVector* segvec, size_t segment_index, size_t* out_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current count of elements. Assumes non-NULL argument. */
+size_t gds_segmented_vector_get_count(const GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the count of elements the allocated segments can hold. Assumes non-NULL argument. */
+size_t gds_segmented_vector_get_capacity(const GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the count of elements each segment holds. Assumes non-NULL argument. */
+size_t gds_segmented_vector_get_segment_capacity(const GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the count of segments that hold at least one element. Assumes non-NULL argument. */
+size_t gds_segmented_vector_get_segment_count(const GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the segmented vector is empty. Assumes non-NULL argument. */
+bool gds_segmented_vector_is_empty(const GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns element size of the segmented vector. Assumes non-NULL argument. */
+size_t gds_segmented_vector_get_element_size(const GDSSegmentedVector* segvec);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSSegmentedVector) and returns the value. */
+size_t gds_segmented_vector_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_SEGMENTED_VECTOR_H_
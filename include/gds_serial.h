@@ -0,0 +1,152 @@
+#ifndef _GDS_SERIAL_H_
+#define _GDS_SERIAL_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+#include "gds_vector.h"
+#include "gds_forward_list.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSSerialReader;
+#else
+#define __GDS_SERIAL_DEF_ALLOW__
+#include "def/gds_serial_def.h"
+#endif
+
+typedef struct GDSSerialReader GDSSerialReader;
+
+/* Binary serialization of containers to and from file descriptors. A serialized container is a header followed by
+ * the elements, packed one after another:
+ * - magic(8 bytes, "GDSSERIA"),
+ * - format version(uint32_t, GDS_SERIAL_VERSION),
+ * - header size(uint32_t) - the elements start right after the header,
+ * - element size(uint64_t),
+ * - count of elements(uint64_t).
+ * All values are stored in the byte order of the machine that wrote them. The elements of any container are stored
+ * in the same way, so data written from a vector can be read into a list and vice versa.
+ * Writes are done with writev(), in as few system calls as possible. Data is read with large read() calls - a vector
+ * is read with a single bulk read into its buffer. GDSSerialReader reads files that don't fit in memory, block by
+ * block, and tells the kernel to read ahead.
+ * File descriptors are never closed by these functions. Reading and writing starts at the descriptor's current
+ * offset(GDSSerialReader uses pread() and leaves the offset unchanged). */
+
+#define GDS_SERIAL_VERSION 1
+#define GDS_SERIAL_DEFAULT_BLOCK_SIZE (1 << 20)
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_SERIAL_ERR_BASE 3300
+#define GDS_SERIAL_ERR_WRITE_FAIL 3301
+#define GDS_SERIAL_ERR_READ_FAIL 3302
+#define GDS_SERIAL_ERR_FILE_INVALID 3303
+#define GDS_SERIAL_ERR_ELEMENT_SIZE_MISMATCH 3304
+#define GDS_SERIAL_ERR_MALLOC_FAIL 3305
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Writes the header and all elements of 'vector' to 'fd' - the header and the vector's buffer are written together
+ * with writev().
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SERIAL_ERR_WRITE_FAIL.
+ * Function may fail if 'fd' < 0, if 'vector' is NULL or if writing fails. */
+gds_err gds_serial_write_vector(int fd, const GDSVector* vector);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reads a serialized container from 'fd' and initializes 'vector' with its elements. 'vector' must not be
+ * initialized. The vector is initialized with gds_vector_init(), with the capacity set to the count of elements,
+ * and the elements are read straight into its buffer with a single bulk read. If 'element_size' is not 0, the
+ * element size stored in the header must be equal to it.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_SERIAL_ERR_READ_FAIL,
+ * GDS_SERIAL_ERR_FILE_INVALID(bad header or not enough data), GDS_SERIAL_ERR_ELEMENT_SIZE_MISMATCH or
+ * GDS_SERIAL_ERR_MALLOC_FAIL. On failure, 'vector' is left uninitialized. */
+gds_err gds_serial_read_vector(int fd, GDSVector* vector, size_t element_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Writes the header and all elements of 'list' to 'fd'. The elements are gathered from the list's nodes with
+ * writev(), up to IOV_MAX nodes per call.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SERIAL_ERR_WRITE_FAIL.
+ * Function may fail if 'fd' < 0, if 'list' is NULL or if writing fails. */
+gds_err gds_serial_write_forward_list(int fd, const GDSForwardList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reads a serialized container from 'fd' and appends its elements to the back of 'list', which must be
+ * initialized. Data is read in blocks of GDS_SERIAL_DEFAULT_BLOCK_SIZE bytes. The element size stored in the header
+ * must be equal to the list's data size.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_SERIAL_ERR_READ_FAIL,
+ * GDS_SERIAL_ERR_FILE_INVALID, GDS_SERIAL_ERR_ELEMENT_SIZE_MISMATCH or GDS_SERIAL_ERR_MALLOC_FAIL. On failure, the
+ * elements that were already appended stay in the list. */
+gds_err gds_serial_read_forward_list(int fd, GDSForwardList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the reader: reads and checks the header at the current offset of 'fd'. Elements are then read in
+ * blocks of about 'block_size' bytes(at least one element). The kernel is told that the file is read sequentially,
+ * and each block read also starts read-ahead of the following block.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_SERIAL_ERR_READ_FAIL,
+ * GDS_SERIAL_ERR_FILE_INVALID or GDS_SERIAL_ERR_MALLOC_FAIL.
+ * Function may fail if 'reader' is NULL, if 'fd' < 0 or if 'block_size' == 0. */
+gds_err gds_serial_reader_init(GDSSerialReader* reader, int fd, size_t block_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSSerialReader. Calls gds_serial_reader_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSSerialReader,
+ * on failure - NULL. */
+GDSSerialReader* gds_serial_reader_create(int fd, size_t block_size);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees the reader's block buffer. Doesn't close the file descriptor. If 'reader' is NULL, the function performs no
+ * action. This doesn't free memory pointed to by 'reader'. */
+void gds_serial_reader_destruct(GDSSerialReader* reader);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reads the next block of elements. The address of the first element is stored into 'out_block' and the count of
+ * elements in the block into 'out_count' - 0 once all elements have been read. The block is valid until the next
+ * call or until the reader is destructed. Pages of the file that have been read are dropped from the page cache, so
+ * reading a file larger than memory doesn't evict other data.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_SERIAL_ERR_READ_FAIL or
+ * GDS_SERIAL_ERR_FILE_INVALID(the file ended before all elements were read). */
+gds_err gds_serial_reader_next_block(GDSSerialReader* reader, const void** out_block, size_t* out_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the element size stored in the header. Assumes non-NULL argument. */
+size_t gds_serial_reader_get_element_size(const GDSSerialReader* reader);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of elements stored in the header. Assumes non-NULL argument. */
+size_t gds_serial_reader_get_count(const GDSSerialReader* reader);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of elements that haven't been read yet. Assumes non-NULL argument. */
+size_t gds_serial_reader_get_remaining_count(const GDSSerialReader* reader);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSSerialReader) and returns the value. */
+size_t gds_serial_reader_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_SERIAL_H_
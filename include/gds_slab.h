@@ -0,0 +1,138 @@
+#ifndef _GDS_SLAB_H_
+#define _GDS_SLAB_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSSlab;
+#else
+#define __GDS_SLAB_DEF_ALLOW__
+#include "def/gds_slab_def.h"
+#endif
+
+typedef struct GDSSlab GDSSlab;
+
+/* GDSSlab is a pool allocator for objects of one fixed size. Memory is taken from the system in chunks, each holding
+ * several objects placed next to each other, so objects allocated one after another are adjacent in memory. Unless
+ * a fixed chunk size is requested, the first chunk holds only a few objects and each following chunk twice as many,
+ * up to about GDS_SLAB_DEFAULT_CHUNK_SIZE bytes - a slab holding few objects stays small.
+ * Each chunk keeps its freed objects on its own free list, and they are handed out again before any new memory is
+ * used. Once none of a chunk's objects are in use, the chunk is freed - unless the slab needs it to hold as many
+ * objects as it has held at once before, in which case it is kept for the following allocations. Destructing the
+ * slab frees all chunks at once.
+ * Objects are aligned to sizeof(void*) bytes - to 16 bytes if the object size is a multiple of 16.
+ * GDSSlab is not thread-safe. */
+
+#define GDS_SLAB_DEFAULT_CHUNK_SIZE (1 << 16)
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_SLAB_ERR_BASE 2400
+#define GDS_SLAB_ERR_MALLOC_FAIL 2401
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the slab for objects of size 'object_size'. Each chunk holds 'objects_per_chunk' objects. If
+ * 'objects_per_chunk' is 0, chunks start small and double in size, up to about GDS_SLAB_DEFAULT_CHUNK_SIZE bytes. No
+ * memory is allocated until the first object is.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'slab' is NULL or if 'object_size' == 0. */
+gds_err gds_slab_init(GDSSlab* slab, size_t object_size, size_t objects_per_chunk);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSSlab. Calls gds_slab_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSSlab,
+ * on failure - NULL. The function can fail because: allocating memory for the new slab failed, or because
+ * gds_slab_init() returned an error code. */
+GDSSlab* gds_slab_create(size_t object_size, size_t objects_per_chunk);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees all chunks, which invalidates every object allocated from the slab. If 'slab' is NULL, the function performs
+ * no action. This doesn't free memory pointed to by 'slab'. */
+void gds_slab_destruct(GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Allocates an object. The object's memory is uninitialized.
+ * Return value:
+ * on success - address of the object,
+ * on failure - NULL. Function may fail if 'slab' is NULL or if allocating a new chunk fails. */
+void* gds_slab_alloc(GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns 'object' to the slab, so it can be handed out again. 'object' must have been allocated from 'slab', or
+ * from a slab that 'slab' absorbed(see gds_slab_absorb()). The object's chunk is found by binary search, in
+ * O(log c) complexity for c chunks. If this frees the last object in use of a chunk, the chunk may be freed too(see
+ * above). If 'slab' or 'object' are NULL, the function performs no action. */
+void gds_slab_free(GDSSlab* slab, void* object);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees all objects at once. The chunks are kept and reused, in address order, by the following allocations.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('slab' is NULL). */
+gds_err gds_slab_reset(GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Allocates chunks until at least 'count' objects can be allocated without allocating memory. Chunks allocated here
+ * don't count towards the growth of chunk sizes.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SLAB_ERR_MALLOC_FAIL. */
+gds_err gds_slab_reserve(GDSSlab* slab, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves the chunks of 'src' to 'dest', without copying or moving any object. Objects allocated from 'src' stay where
+ * they are, but now belong to 'dest' and must be freed to it. Chunks of 'src' with no objects in use are freed
+ * instead. Afterwards, 'src' holds no chunks and can be used again. The function takes O(c) complexity, where c is
+ * the count of chunks of both slabs, regardless of how many objects are in use. Moved chunks are freed by 'dest'
+ * once their objects are, so absorbing repeatedly doesn't make 'dest' grow beyond the most objects it has held at
+ * once.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_GEN_ERR_INCONSISTENT_ARGS(if
+ * 'dest' and 'src' are the same slab or have different object sizes) or GDS_SLAB_ERR_MALLOC_FAIL. If the function
+ * fails, both slabs are unchanged. */
+gds_err gds_slab_absorb(GDSSlab* dest, GDSSlab* src);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the size of each object - the requested size, rounded up to a multiple of sizeof(void*). Assumes non-NULL
+ * argument. */
+size_t gds_slab_get_object_size(const GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of objects that are allocated and not freed. Assumes non-NULL argument. */
+size_t gds_slab_get_used_count(const GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of allocated chunks. Assumes non-NULL argument. */
+size_t gds_slab_get_chunk_count(const GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of objects all chunks can hold together - allocated or not. Assumes non-NULL argument. */
+size_t gds_slab_get_capacity(const GDSSlab* slab);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSSlab) and returns the value. */
+size_t gds_slab_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_SLAB_H_
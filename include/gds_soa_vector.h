@@ -0,0 +1,184 @@
+#ifndef _GDS_SOA_VECTOR_H_
+#define _GDS_SOA_VECTOR_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSSoAVector;
+#else
+#define __GDS_SOA_VECTOR_DEF_ALLOW__
+#include "def/gds_soa_vector_def.h"
+#endif
+
+typedef struct GDSSoAVector GDSSoAVector;
+
+/* GDSSoAVector is a growable sequence of records, stored as a struct of arrays: each field of the record has its own
+ * contiguous column(a GDSArray), and the record with index i is made up of element i of every column. The fields
+ * are declared by a list of field sizes. A scan that reads one field only touches that field's column.
+ * Records are passed as arrays of 'field_count' pointers - pointer i points to the value of field i. Operations that
+ * add or remove records keep all columns in sync. Column addresses(gds_soa_vector_get_column()) are invalidated when
+ * the vector grows. */
+
+#define GDS_SOA_DEFAULT_RESIZE_FACTOR 2
+#define GDS_SOA_DEFAULT_INITIAL_CAPACITY 10
+#define GDS_SOA_MIN_RESIZE_FACTOR 1.1
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_SOA_ERR_BASE 800
+#define GDS_SOA_ERR_SOA_EMPTY 801
+#define GDS_SOA_ERR_MALLOC_FAIL 802
+#define GDS_SOA_ERR_REALLOC_FAIL 803
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the SoA vector with 'field_count' fields. Field i is 'field_sizes'[i] bytes large. Dynamically
+ * allocates each column, so it can hold 'initial_capacity' records.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SOA_ERR_MALLOC_FAIL.
+ * Function may fail if 'soa' or 'field_sizes' are NULL, if 'field_count' == 0, if any of the field sizes is 0, if
+ * 'initial_capacity' == 0 or if 'resize_factor' <= GDS_SOA_MIN_RESIZE_FACTOR. */
+gds_err gds_soa_vector_init(GDSSoAVector* soa, const size_t* field_sizes, size_t field_count, size_t initial_capacity,
+        double resize_factor);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for GDSSoAVector. Calls gds_soa_vector_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSSoAVector,
+ * on failure - NULL. The function can fail because: allocating memory for the new SoA vector failed, or because
+ * gds_soa_vector_init() returned an error code. */
+GDSSoAVector* gds_soa_vector_create(const size_t* field_sizes, size_t field_count, size_t initial_capacity,
+        double resize_factor);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the columns. If 'soa' is NULL, the function performs no action. This
+ * doesn't free memory pointed to by 'soa'. */
+void gds_soa_vector_destruct(GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of field 'field' of the record at index 'pos'.
+ * Return value:
+ * on success - address of the field's value,
+ * on failure - NULL. Function may fail if 'soa' is NULL, or if 'field' or 'pos' are out of bounds. */
+void* gds_soa_vector_at(const GDSSoAVector* soa, size_t field, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the first element of column 'field'. The column holds gds_soa_vector_get_count() elements
+ * of gds_soa_vector_get_field_size() bytes each, contiguously. The address is valid until the vector grows.
+ * Return value:
+ * on success - address of the column,
+ * on failure - NULL. Function may fail if 'soa' is NULL or if 'field' is out of bounds. */
+void* gds_soa_vector_get_column(const GDSSoAVector* soa, size_t field);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the fields of the record at index 'pos' into the locations pointed to by 'out_fields'[0 .. field count - 1].
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'soa' or 'out_fields' are NULL, or if 'pos' is out of bounds. */
+gds_err gds_soa_vector_get_record(const GDSSoAVector* soa, size_t pos, void* const* out_fields);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the values pointed to by 'fields'[0 .. field count - 1] into the fields of the record at index 'pos'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'soa' or 'fields' are NULL, or if 'pos' is out of bounds. */
+gds_err gds_soa_vector_assign(GDSSoAVector* soa, const void* const* fields, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Appends a record. If the vector is at its capacity, all columns are grown by the resize factor first.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SOA_ERR_REALLOC_FAIL.
+ * Function may fail if 'soa' or 'fields' are NULL, or if growing a column fails - the record is then not added. */
+gds_err gds_soa_vector_push_back(GDSSoAVector* soa, const void* const* fields);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Inserts a record at index 'pos', shifting the records at index 'pos' and after it to the right, in all columns.
+ * 'pos' may be equal to the count of records.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SOA_ERR_REALLOC_FAIL.
+ * Function may fail if 'soa' or 'fields' are NULL, if 'pos' is out of bounds or if growing a column fails. */
+gds_err gds_soa_vector_insert_at(GDSSoAVector* soa, const void* const* fields, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the record at index 'pos', shifting the records after it to the left, in all columns.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'soa' is NULL or if 'pos' is out of bounds. */
+gds_err gds_soa_vector_remove_at(GDSSoAVector* soa, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes the last record.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SOA_ERR_SOA_EMPTY. */
+gds_err gds_soa_vector_pop_back(GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Removes all records. The capacity is kept.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument('soa' is NULL). */
+gds_err gds_soa_vector_empty(GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Grows all columns so they can hold at least 'new_capacity' records. If 'new_capacity' is less or equal to the
+ * current capacity, the function performs nothing.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing an invalid argument or GDS_SOA_ERR_REALLOC_FAIL. */
+gds_err gds_soa_vector_reserve(GDSSoAVector* soa, size_t new_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current count of records. Assumes non-NULL argument. */
+size_t gds_soa_vector_get_count(const GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets current capacity(in records). Assumes non-NULL argument. */
+size_t gds_soa_vector_get_capacity(const GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the SoA vector is empty. Assumes non-NULL argument. */
+bool gds_soa_vector_is_empty(const GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the count of fields. Assumes non-NULL argument. */
+size_t gds_soa_vector_get_field_count(const GDSSoAVector* soa);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Gets the size of field 'field'. Returns 0 if 'soa' is NULL or if 'field' is out of bounds. */
+size_t gds_soa_vector_get_field_size(const GDSSoAVector* soa, size_t field);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSSoAVector) and returns the value. */
+size_t gds_soa_vector_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_SOA_VECTOR_H_
@@ -0,0 +1,114 @@
+#ifndef _GDS_SPSC_QUEUE_H_
+#define _GDS_SPSC_QUEUE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSSPSCQueue;
+#else
+#define __GDS_SPSC_QUEUE_DEF_ALLOW__
+#include "def/gds_spsc_queue_def.h"
+#endif
+
+typedef struct GDSSPSCQueue GDSSPSCQueue;
+
+/* GDSSPSCQueue is a bounded, lock-free, single-producer/single-consumer FIFO queue of fixed-size elements. It is
+ * a ring buffer of 'capacity' slots of 'element_size' bytes each. Exactly one thread may enqueue and exactly one
+ * (possibly different) thread may dequeue at the same time - no other synchronization is needed between the two.
+ * The producer's and the consumer's positions are kept on separate cache lines. Each side also keeps a cached copy
+ * of the other side's position, so the shared position is only read when the cached one says the queue is
+ * full(or empty).
+ * Because the struct is cache-line aligned, a queue that isn't created by gds_spsc_queue_create() must be
+ * placed in memory aligned to GDS_CACHE_LINE_SIZE. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_SPSC_ERR_BASE 500
+#define GDS_SPSC_ERR_QUEUE_FULL 501
+#define GDS_SPSC_ERR_QUEUE_EMPTY 502
+#define GDS_SPSC_ERR_MALLOC_FAIL 503
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the queue, so it can hold 'capacity' elements(rounded up to a power of two). Not thread-safe.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SPSC_ERR_MALLOC_FAIL.
+ * Function may fail if 'queue' is NULL, 'element_size' == 0 or 'capacity' == 0. */
+gds_err gds_spsc_queue_init(GDSSPSCQueue* queue, size_t element_size, size_t capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates cache-line aligned memory for GDSSPSCQueue. Calls gds_spsc_queue_init() to initialize it.
+ * Return value:
+ * on success - address of dynamically allocated GDSSPSCQueue,
+ * on failure - NULL. The function can fail because: allocating memory for the new queue failed, or because
+ * gds_spsc_queue_init() returned an error code. */
+GDSSPSCQueue* gds_spsc_queue_create(size_t element_size, size_t capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees dynamically allocated memory for the queue. Not thread-safe - neither side may use the queue anymore.
+ * If 'queue' is NULL, the function performs no action. This doesn't free memory pointed to by 'queue'. */
+void gds_spsc_queue_destruct(GDSSPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the element pointed to by 'data' into the queue. May only be called by the producer.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SPSC_ERR_QUEUE_FULL.
+ * Function may fail if 'queue' or 'data' are NULL, or if the queue is full. */
+gds_err gds_spsc_queue_enqueue(GDSSPSCQueue* queue, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the oldest element of the queue into 'out' and removes it. May only be called by the consumer.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_SPSC_ERR_QUEUE_EMPTY.
+ * Function may fail if 'queue' or 'out' are NULL, or if the queue is empty. */
+gds_err gds_spsc_queue_dequeue(GDSSPSCQueue* queue, void* out);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Enqueues up to 'count' elements stored contiguously at 'data', with at most two memcpy() calls and a single
+ * publication of the new position. May only be called by the producer.
+ * Return value: the number of enqueued elements(the first ones from 'data'). 0 if the queue is full or if 'queue'
+ * or 'data' are NULL. */
+size_t gds_spsc_queue_enqueue_n(GDSSPSCQueue* queue, const void* data, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dequeues up to 'max_count' elements into 'out', with at most two memcpy() calls and a single publication of the
+ * new position. May only be called by the consumer.
+ * Return value: the number of dequeued elements. 0 if the queue is empty or if 'queue' or 'out' are NULL. */
+size_t gds_spsc_queue_dequeue_n(GDSSPSCQueue* queue, void* out, size_t max_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of elements in the queue. The value may already be stale when returned if the other side is
+ * active. Assumes non-NULL argument. */
+size_t gds_spsc_queue_get_count(const GDSSPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the capacity of the queue. Assumes non-NULL argument. */
+size_t gds_spsc_queue_get_capacity(const GDSSPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns element size of the queue. Assumes non-NULL argument. */
+size_t gds_spsc_queue_get_element_size(const GDSSPSCQueue* queue);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSSPSCQueue) and returns the value. */
+size_t gds_spsc_queue_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_SPSC_QUEUE_H_
@@ -0,0 +1,195 @@
+#ifndef _GDS_TYPED_VECTOR_H_
+#define _GDS_TYPED_VECTOR_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "gds.h"
+#include "gds_vector.h"
+
+// The typed vector operations access the vector's fields directly, so the definition is needed regardless of
+// GDS_ENABLE_OPAQUE_STRUCTS.
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "def/gds_vector_def.h"
+
+/* GDS_VECTOR_DEFINE(name, T) generates a vector type 'name' for elements of type 'T', together with a set of
+ * static inline functions prefixed with 'name'. The element size is a compile-time constant and elements are
+ * read and written through plain 'T*' accesses instead of memcpy(), so the compiler is free to inline, unroll
+ * and vectorize loops over the data. Only operations that have to reallocate call into the library.
+ *
+ * 'name' wraps a struct GDSVector as its only member. name_as_vector() and name_from_vector() convert between the
+ * two, so a typed vector can be passed to any gds_vector_*() function and vice versa - as long as the GDSVector's
+ * element size is sizeof(T).
+ *
+ * Unlike the gds_vector_*() functions, the accessors don't validate their arguments - 'pos' must be in bounds and
+ * the vector must be non-NULL and initialized. Example:
+ *
+ * GDS_VECTOR_DEFINE(IntVector, int)
+ *
+ * IntVector v;
+ * IntVector_init(&v, 16);
+ * IntVector_push_back(&v, 42);
+ * int* it;
+ * for(it = IntVector_begin(&v); it != IntVector_end(&v); it++) ...
+ * IntVector_destruct(&v); */
+
+#define GDS_VECTOR_DEFINE(name, T)                                                                                  \
+                                                                                                                    \
+typedef struct name                                                                                                 \
+{                                                                                                                   \
+    struct GDSVector _vector;                                                                                       \
+} name;                                                                                                             \
+                                                                                                                    \
+/* Initializes the vector. Return value is the same as gds_vector_init(). */                                        \
+static inline gds_err name##_init(name* vector, size_t initial_capacity)                                            \
+{                                                                                                                   \
+    return gds_vector_init(&vector->_vector, sizeof(T), initial_capacity, GDS_VEC_DEFAULT_RESIZE_FACTOR);           \
+}                                                                                                                   \
+                                                                                                                    \
+static inline void name##_destruct(name* vector)                                                                    \
+{                                                                                                                   \
+    gds_vector_destruct(&vector->_vector);                                                                          \
+}                                                                                                                   \
+                                                                                                                    \
+static inline GDSVector* name##_as_vector(name* vector)                                                             \
+{                                                                                                                   \
+    return &vector->_vector;                                                                                        \
+}                                                                                                                   \
+                                                                                                                    \
+/* Returns NULL if 'vector' is NULL or its element size isn't sizeof(T). */                                         \
+static inline name* name##_from_vector(GDSVector* vector)                                                           \
+{                                                                                                                   \
+    if((vector == NULL) || (vector->_data._element_size != sizeof(T))) return NULL;                                 \
+    return (name*)vector;                                                                                           \
+}                                                                                                                   \
+                                                                                                                    \
+static inline size_t name##_count(const name* vector)                                                               \
+{                                                                                                                   \
+    return vector->_vector._data._count;                                                                            \
+}                                                                                                                   \
+                                                                                                                    \
+static inline size_t name##_capacity(const name* vector)                                                            \
+{                                                                                                                   \
+    return vector->_vector._data._capacity;                                                                         \
+}                                                                                                                   \
+                                                                                                                    \
+static inline bool name##_is_empty(const name* vector)                                                              \
+{                                                                                                                   \
+    return (vector->_vector._data._count == 0);                                                                     \
+}                                                                                                                   \
+                                                                                                                    \
+static inline T* name##_data(const name* vector)                                                                    \
+{                                                                                                                   \
+    return (T*)vector->_vector._data._data;                                                                         \
+}                                                                                                                   \
+                                                                                                                    \
+static inline T* name##_begin(const name* vector)                                                                   \
+{                                                                                                                   \
+    return (T*)vector->_vector._data._data;                                                                         \
+}                                                                                                                   \
+                                                                                                                    \
+static inline T* name##_end(const name* vector)                                                                     \
+{                                                                                                                   \
+    return (T*)vector->_vector._data._data + vector->_vector._data._count;                                          \
+}                                                                                                                   \
+                                                                                                                    \
+static inline T* name##_at(const name* vector, size_t pos)                                                          \
+{                                                                                                                   \
+    return (T*)vector->_vector._data._data + pos;                                                                   \
+}                                                                                                                   \
+                                                                                                                    \
+static inline T name##_get(const name* vector, size_t pos)                                                          \
+{                                                                                                                   \
+    return ((T*)vector->_vector._data._data)[pos];                                                                  \
+}                                                                                                                   \
+                                                                                                                    \
+static inline void name##_set(name* vector, size_t pos, T value)                                                    \
+{                                                                                                                   \
+    ((T*)vector->_vector._data._data)[pos] = value;                                                                 \
+}                                                                                                                   \
+                                                                                                                    \
+static inline T* name##_back(const name* vector)                                                                    \
+{                                                                                                                   \
+    return (T*)vector->_vector._data._data + (vector->_vector._data._count - 1);                                    \
+}                                                                                                                   \
+                                                                                                                    \
+/* Grows the capacity by the vector's resize factor. Kept out of line, so that push_back() stays small. */          \
+static __attribute__((noinline)) gds_err name##_grow(name* vector)                                                  \
+{                                                                                                                   \
+    size_t count = vector->_vector._data._count;                                                                    \
+    size_t new_capacity = (size_t)(count * vector->_vector._resize_factor);                                         \
+    if(new_capacity <= count) new_capacity = count + 1;                                                             \
+    return gds_vector_reserve(&vector->_vector, new_capacity);                                                      \
+}                                                                                                                   \
+                                                                                                                    \
+/* Returns GDS_SUCCESS or GDS_VEC_ERR_REALLOC_FAIL - the vector is unchanged in the latter case. */                 \
+static inline gds_err name##_push_back(name* vector, T value)                                                       \
+{                                                                                                                   \
+    if(vector->_vector._data._count == vector->_vector._data._capacity)                                             \
+    {                                                                                                               \
+        if(name##_grow(vector) != GDS_SUCCESS) return GDS_VEC_ERR_REALLOC_FAIL;                                     \
+    }                                                                                                               \
+                                                                                                                    \
+    ((T*)vector->_vector._data._data)[vector->_vector._data._count++] = value;                                      \
+    return GDS_SUCCESS;                                                                                             \
+}                                                                                                                   \
+                                                                                                                    \
+/* Removes the last element and returns it. Assumes a non-empty vector. */                                          \
+static inline T name##_pop_back(name* vector)                                                                       \
+{                                                                                                                   \
+    return ((T*)vector->_vector._data._data)[--vector->_vector._data._count];                                       \
+}                                                                                                                   \
+                                                                                                                    \
+/* Inserts 'value' at 'pos'('pos' <= count), shifting the following elements right. */                             \
+static inline gds_err name##_insert_at(name* vector, size_t pos, T value)                                          \
+{                                                                                                                   \
+    if(vector->_vector._data._count == vector->_vector._data._capacity)                                             \
+    {                                                                                                               \
+        if(name##_grow(vector) != GDS_SUCCESS) return GDS_VEC_ERR_REALLOC_FAIL;                                     \
+    }                                                                                                               \
+                                                                                                                    \
+    T* data = (T*)vector->_vector._data._data;                                                                      \
+    memmove(data + pos + 1, data + pos, (vector->_vector._data._count - pos) * sizeof(T));                          \
+    data[pos] = value;                                                                                              \
+    vector->_vector._data._count++;                                                                                 \
+    return GDS_SUCCESS;                                                                                             \
+}                                                                                                                   \
+                                                                                                                    \
+/* Removes the element at 'pos'('pos' < count), shifting the following elements left. */                           \
+static inline void name##_remove_at(name* vector, size_t pos)                                                       \
+{                                                                                                                   \
+    T* data = (T*)vector->_vector._data._data;                                                                      \
+    memmove(data + pos, data + pos + 1, (vector->_vector._data._count - pos - 1) * sizeof(T));                      \
+    vector->_vector._data._count--;                                                                                 \
+}                                                                                                                   \
+                                                                                                                    \
+static inline gds_err name##_reserve(name* vector, size_t new_capacity)                                             \
+{                                                                                                                   \
+    if(new_capacity <= vector->_vector._data._capacity) return GDS_SUCCESS;                                         \
+    return gds_vector_reserve(&vector->_vector, new_capacity);                                                      \
+}                                                                                                                   \
+                                                                                                                    \
+/* Sets the count to 'new_count', growing the capacity if needed. New elements are set to 'fill'. */                \
+static inline gds_err name##_resize(name* vector, size_t new_count, T fill)                                         \
+{                                                                                                                   \
+    if(new_count > vector->_vector._data._capacity)                                                                 \
+    {                                                                                                               \
+        if(gds_vector_reserve(&vector->_vector, new_count) != GDS_SUCCESS) return GDS_VEC_ERR_REALLOC_FAIL;         \
+    }                                                                                                               \
+                                                                                                                    \
+    T* data = (T*)vector->_vector._data._data;                                                                      \
+    size_t i;                                                                                                       \
+    for(i = vector->_vector._data._count; i < new_count; i++) data[i] = fill;                                       \
+    vector->_vector._data._count = new_count;                                                                       \
+    return GDS_SUCCESS;                                                                                             \
+}                                                                                                                   \
+                                                                                                                    \
+static inline void name##_clear(name* vector)                                                                       \
+{                                                                                                                   \
+    vector->_vector._data._count = 0;                                                                               \
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_TYPED_VECTOR_H_
@@ -0,0 +1,154 @@
+#ifndef _GDS_UNCHECKED_H_
+#define _GDS_UNCHECKED_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_vector.h"
+
+// The accessors read the structs' fields directly, so the definitions are needed regardless of
+// GDS_ENABLE_OPAQUE_STRUCTS.
+#define __GDS_ARRAY_DEF_ALLOW__
+#include "def/gds_array_def.h"
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "def/gds_vector_def.h"
+
+/* Unchecked, inlinable accessors for GDSArray and GDSVector, for hot loops. gds_array_at() and gds_vector_at() are
+ * calls into the library that validate their arguments on every access - the functions below are static inline, do
+ * no validation and compile down to plain pointer arithmetic. They can be freely mixed with the checked API.
+ *
+ * Arguments must be valid: the array/vector must be non-NULL and initialized, and 'pos' must be in bounds. If
+ * GDS_DEBUG is defined(and NDEBUG isn't), these conditions are checked with assert().
+ *
+ * Pointers returned by these functions are invalidated by any operation that reallocates the data(growing, fitting,
+ * inserting past the capacity...). Example:
+ *
+ * GDS_VECTOR_FOR_EACH(vector, int, it) sum += *it; */
+
+#ifdef GDS_DEBUG
+#define _GDS_UNCHECKED_ASSERT(cond) assert(cond)
+#else
+#define _GDS_UNCHECKED_ASSERT(cond) ((void)0)
+#endif // GDS_DEBUG
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element at index 'pos'. */
+static inline void* gds_array_at_unchecked(const GDSArray* array, size_t pos)
+{
+    _GDS_UNCHECKED_ASSERT(array != NULL);
+    _GDS_UNCHECKED_ASSERT(pos < array->_count);
+
+    return (char*)array->_data + (pos * array->_element_size);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the first element. */
+static inline void* gds_array_data(const GDSArray* array)
+{
+    _GDS_UNCHECKED_ASSERT(array != NULL);
+
+    return array->_data;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address one past the last element. */
+static inline void* gds_array_end(const GDSArray* array)
+{
+    _GDS_UNCHECKED_ASSERT(array != NULL);
+
+    return (char*)array->_data + (array->_count * array->_element_size);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of elements. */
+static inline size_t gds_array_get_count_unchecked(const GDSArray* array)
+{
+    _GDS_UNCHECKED_ASSERT(array != NULL);
+
+    return array->_count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element at index 'pos'. */
+static inline void* gds_vector_at_unchecked(const GDSVector* vector, size_t pos)
+{
+    _GDS_UNCHECKED_ASSERT(vector != NULL);
+
+    return gds_array_at_unchecked(&vector->_data, pos);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the first element. */
+static inline void* gds_vector_data(const GDSVector* vector)
+{
+    _GDS_UNCHECKED_ASSERT(vector != NULL);
+
+    return gds_array_data(&vector->_data);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address one past the last element. */
+static inline void* gds_vector_end(const GDSVector* vector)
+{
+    _GDS_UNCHECKED_ASSERT(vector != NULL);
+
+    return gds_array_end(&vector->_data);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of elements. */
+static inline size_t gds_vector_get_count_unchecked(const GDSVector* vector)
+{
+    _GDS_UNCHECKED_ASSERT(vector != NULL);
+
+    return vector->_data._count;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Iterates over the elements of 'array', whose elements are of type 'T'. Declares 'it', of type 'T*', which points to
+ * the current element. The end is computed once, before the first iteration, so elements must not be added or
+ * removed in the loop body. 'break' and 'continue' work as in a plain loop. In debug builds, the element size is
+ * checked against sizeof(T). */
+#define GDS_ARRAY_FOR_EACH(array, T, it)                                                                            \
+    for(struct { T* end; } _gds_loop_##it =                                                                         \
+            { (_GDS_UNCHECKED_ASSERT((array)->_element_size == sizeof(T)), (T*)gds_array_end(array)) };                \
+            _gds_loop_##it.end != NULL; _gds_loop_##it.end = NULL)                                                  \
+        for(T* it = (T*)gds_array_data(array); it != _gds_loop_##it.end; it++)
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as GDS_ARRAY_FOR_EACH(), for a GDSVector. */
+#define GDS_VECTOR_FOR_EACH(vector, T, it)                                                                          \
+    GDS_ARRAY_FOR_EACH(&(vector)->_data, T, it)
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Iterates over the elements of 'array' by address, without knowing their type. Declares 'it', of type 'char*',
+ * which points to the first byte of the current element. The same restrictions as for GDS_ARRAY_FOR_EACH() apply. */
+#define GDS_ARRAY_FOR_EACH_RAW(array, it)                                                                           \
+    for(struct { char* end; size_t step; } _gds_loop_##it =                                                         \
+            { (char*)gds_array_end(array), (array)->_element_size };                                                \
+            _gds_loop_##it.end != NULL; _gds_loop_##it.end = NULL)                                                  \
+        for(char* it = (char*)gds_array_data(array); it != _gds_loop_##it.end; it += _gds_loop_##it.step)
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as GDS_ARRAY_FOR_EACH_RAW(), for a GDSVector. */
+#define GDS_VECTOR_FOR_EACH_RAW(vector, it)                                                                         \
+    GDS_ARRAY_FOR_EACH_RAW(&(vector)->_data, it)
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_UNCHECKED_H_
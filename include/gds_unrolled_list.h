@@ -0,0 +1,224 @@
+#ifndef _GDS_UNROLLED_LIST_H_
+#define _GDS_UNROLLED_LIST_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "gds.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+struct GDSUnrolledList;
+struct GDSUnrolledListIterator;
+#else
+#define __GDS_UNROLLED_LIST_DEF_ALLOW__
+#include "def/gds_unrolled_list_def.h"
+#endif
+
+typedef struct GDSUnrolledList GDSUnrolledList;
+typedef struct GDSUnrolledListIterator GDSUnrolledListIterator;
+
+/* GDSUnrolledList is a singly linked list that stores several elements per node, contiguously. The count of elements
+ * per node is chosen from the data size, so a node fills about two cache lines. Iterating the list then costs one
+ * cache miss per node instead of one per element, and the 'next' pointer is shared by all elements of a node.
+ * The API mirrors GDSForwardList. Inserting into a full node splits it in two. When removing leaves a node less than
+ * half full, it is merged with the following node, if the elements of both fit into one node.
+ * Addresses of elements are invalidated by insertions and removals in the same node. */
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#define GDS_UNRLIST_ERR_BASE 2300
+#define GDS_UNRLIST_ERR_LIST_EMPTY 2301
+#define GDS_UNRLIST_ERR_MALLOC_FAIL 2302
+
+#define GDS_UNRLIST_ITER_ERR_OUT_OF_BOUNDS 2303
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes 'list' by setting values for its fields. This function is to be used only on uninitialized lists
+ * (gds_unrolled_list_create initializes the list). It may also be used after gds_unrolled_list_destruct().
+ * data_size must be greater than 0. _on_element_removal_func may be NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments. */
+gds_err gds_unrolled_list_init(GDSUnrolledList* list, size_t data_size, void (*_on_element_removal_func)(void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for a GDSUnrolledList. Performs a call to gds_unrolled_list_init() to initialize it.
+ * Return value:
+ * on success: address of newly allocated GDSUnrolledList,
+ * on failure: NULL.
+ * Function may fail if the memory allocation for the list failed, or if gds_unrolled_list_init() failed. */
+GDSUnrolledList* gds_unrolled_list_create(size_t data_size, void (*_on_element_removal_func)(void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Used as a destructor. Sets values of 'list' fields to default values.
+ * Removes all elements from the list(invocations of list->_on_element_removal_func will be made).
+ * If 'list' is NULL, function performs nothing. This doesn't free memory pointed to by 'list'. */
+void gds_unrolled_list_destruct(GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves address of element with index 'pos' inside the list. Elements of the tail node are found in O(1),
+ * others in O(n / node capacity).
+ * Return value:
+ * on success: address of element with index 'pos',
+ * on failure: NULL. Function may fail if provided 'list' argument is NULL or if 'pos' is out of bounds. */
+void* gds_unrolled_list_at(const GDSUnrolledList* list, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Assigns data pointed to by 'data' to element with index 'pos' inside the list. This is done via memcpy().
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments.
+ * Function may fail if 'list' or 'data' are NULL or if 'pos' is out of bounds. */
+gds_err gds_unrolled_list_assign(GDSUnrolledList* list, const void* data, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions swaps data of elements with indices 'pos1' and 'pos2'. Function performs no action if pos1 == pos2.
+ * Make sure that swap_buff is of at least list->data_size size.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments.
+ * Function may fail if 'list' or 'swap_buff' are NULL or 'pos1' or 'pos2' are out of bounds. */
+gds_err gds_unrolled_list_swap(GDSUnrolledList* list, size_t pos1, size_t pos2, void* swap_buff);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions appends a new element at the end of a list in O(1) complexity.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_UNRLIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list' or 'data' are NULL, or if dynamic allocation of a new node fails. */
+gds_err gds_unrolled_list_push_back(GDSUnrolledList* list, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions appends a new element at the start of a list in O(node capacity) complexity - the elements of the head
+ * node are shifted.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_UNRLIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list' or 'data' are NULL, or if dynamic allocation of a new node fails. */
+gds_err gds_unrolled_list_push_front(GDSUnrolledList* list, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Functions inserts a new element at index 'pos' in the list. Finding the node is O(n / node capacity), inserting
+ * into it is O(node capacity). If the node is full, it is split in two.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_UNRLIST_ERR_MALLOC_FAIL.
+ * Function may fail if 'list' or 'data' are NULL, or if dynamic allocation of a new node fails. The
+ * function may also fail if 'pos' is out of bounds. */
+gds_err gds_unrolled_list_insert_at(GDSUnrolledList* list, const void* data, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes an element from the start of the list.
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL)
+ * or GDS_UNRLIST_ERR_LIST_EMPTY. */
+gds_err gds_unrolled_list_pop_front(GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function removes an element with index 'pos' from the list. Complexity is the same as for
+ * gds_unrolled_list_insert_at().
+ * This function will invoke list->_on_element_removal_func for the removed element, if non-NULL.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL or if 'pos' is out
+ * of bounds). */
+gds_err gds_unrolled_list_remove_at(GDSUnrolledList* list, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function empties the list.
+ * This function will invoke list->_on_element_removal_func for each removed element, if non-NULL.
+ * If the list is already empty, the function performs no action and returns GDS_SUCCESS.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' is NULL). */
+gds_err gds_unrolled_list_empty(GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves list->_data_size. This function assumes a non-NULL 'list' argument */
+size_t gds_unrolled_list_get_data_size(const GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves list->_count. This function assumes a non-NULL 'list' argument */
+size_t gds_unrolled_list_get_count(const GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the max count of elements stored in one node. This function assumes a non-NULL 'list' argument */
+size_t gds_unrolled_list_get_node_capacity(const GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the unrolled list is empty. This function assumes a non-NULL 'list' argument. */
+bool gds_unrolled_list_is_empty(const GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs sizeof(GDSUnrolledList) and returns the value. */
+size_t gds_unrolled_list_get_struct_size();
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Initializes the GDSUnrolledList iterator. The iterator will point at the first element of the list.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments(if 'list' or 'iterator' is NULL.)
+ * or GDS_UNRLIST_ERR_LIST_EMPTY. */
+gds_err gds_unrolled_list_iterator_init(GDSUnrolledList* list, GDSUnrolledListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dynamically allocates memory for the iterator and invokes gds_unrolled_list_iterator_init() to initialize it.
+ * The caller is responsible for freeing the dynamically allocated memory for the GDSUnrolledListIterator after
+ * using it.
+ * Return value:
+ * on success: address of the newly allocated GDSUnrolledListIterator,
+ * on failure: NULL.
+ * Function may fail if 'list' is NULL, allocation for GDSUnrolledListIterator fails, or if the call to
+ * gds_unrolled_list_iterator_init() function fails. */
+GDSUnrolledListIterator* gds_unrolled_list_iterator_create(GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves iterator to the next element - inside the same node, or to the first element of the next node.
+ * Return value:
+ * on success: GDS_SUCCESS,
+ * on failure: one of the generic error codes representing invalid arguments or GDS_UNRLIST_ITER_ERR_OUT_OF_BOUNDS.
+ * Function may fail if 'iterator' is NULL or the iterator is at the end of the list.
+ * Function may also return GDS_FAILURE if the program is an undefined state - if iterator is pointing at a NULL node. */
+gds_err gds_unrolled_list_iterator_next(GDSUnrolledListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if the iterator has a next element to move to. The iterator doesn't have a next element when pointing to the
+ * end of a list. Function assumes non-NULL 'iterator' */
+bool gds_unrolled_list_iterator_has_next(GDSUnrolledListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the data of the element the iterator is pointing at. Function assumes non-NULL 'iterator' */
+void* gds_unrolled_list_iterator_get_data(GDSUnrolledListIterator* iterator);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Retrieves the position of the element the iterator is pointing at. Function assumes non-NULL 'iterator' */
+size_t gds_unrolled_list_iterator_get_pos(GDSUnrolledListIterator* iterator);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // _GDS_UNROLLED_LIST_H_
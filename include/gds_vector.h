@@ -41,6 +41,41 @@ gds_err gds_vector_init(GDSVector* vector, size_t element_size, size_t initial_c
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Initializes GDSVector vector in huge-vector mode. The vector's data is placed in an anonymous memory mapping
+ * created by gds_array_init_huge(): growing the vector resizes the mapping with mremap() instead of copying the data,
+ * and large mappings are backed by transparent huge pages. Meant for vectors of hundreds of millions of elements.
+ * The rest of the vector API works the same as for regular vectors. Available on Linux only.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_ARR_ERR_MMAP_FAIL or
+ * GDS_ARR_ERR_STORAGE_UNSUPPORTED. Function may fail for the same arguments as gds_vector_init(). */
+gds_err gds_vector_init_huge(GDSVector* vector, size_t element_size, size_t initial_capacity, double resize_factor);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Initializes GDSVector vector as a persistent vector, stored in a memory-mapped file at 'path'. The file is opened
+ * (or created) by gds_array_init_file() - see its description for the file format and the behavior when reopening.
+ * Reopening a file restores the vector's count and element size from the file's header, with no copying of
+ * elements. When reopening, 'element_size' may be 0 to accept the element size stored in the file. Growing the
+ * vector extends the file. Call gds_vector_flush() to make the vector's state durable.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument, GDS_ARR_ERR_FILE_OPEN_FAIL,
+ * GDS_ARR_ERR_FILE_INVALID, GDS_ARR_ERR_MMAP_FAIL or GDS_ARR_ERR_STORAGE_UNSUPPORTED. */
+gds_err gds_vector_init_file(GDSVector* vector, const char* path, size_t element_size, size_t initial_capacity,
+        double resize_factor);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Writes the count of a file-backed vector to its file's header and flushes all modified data to disk, by calling
+ * gds_array_flush(). If the vector isn't file-backed, the function performs no action.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_ARR_ERR_SYNC_FAIL. */
+gds_err gds_vector_flush(GDSVector* vector);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Dynamically allocates memory for GDSVector. Calls gds_vector_init() to initialize the newly created vector.
  * Return value:
  * on success - address of dynamically allocated GDSVector. 
@@ -183,6 +218,34 @@ ssize_t gds_vector_find(GDSVector* vector, const void* data, bool (*compare_func
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* Finds the first element whose bytes are equal to the bytes pointed to by 'data'. Performs a call to
+ * gds_array_find_bytes() - see its description for details.
+ * Return value:
+ * on success - index of the found element,
+ * on failure - -1. Function may fail if 'vector' or 'data' are NULL or if no such element exists. */
+ssize_t gds_vector_find_bytes(const GDSVector* vector, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sorts the vector in ascending order, as defined by 'compare_func'. Performs a call to gds_array_sort() - see
+ * its description for details about the algorithm and 'compare_func'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument.
+ * Function may fail if 'vector' or 'compare_func' are NULL. */
+gds_err gds_vector_sort(GDSVector* vector, int (*compare_func)(const void*, const void*));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sorts the vector in ascending order by an integer key embedded in each element. Performs a call to
+ * gds_array_radix_sort() - see its description for the meaning of 'key_offset', 'key_width' and 'key_signed'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - one of the generic error codes representing an invalid argument or GDS_VEC_ERR_MALLOC_FAIL. */
+gds_err gds_vector_radix_sort(GDSVector* vector, size_t key_offset, size_t key_width, bool key_signed);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /* Sets resize factor of vector. This will impact future resize operations. 'new_resize_factor' must be
  * greater than 1. */
 gds_err gds_vector_set_resize_factor(GDSVector* vector, double new_resize_factor);
@@ -1,11 +1,24 @@
+#ifdef __linux__
+#define _GNU_SOURCE // mremap()
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // __linux__
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "gds.h"
 #include "gds_misc.h"
 #include "gds_array.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
 #ifdef GDS_ENABLE_OPAQUE_STRUCTS
 #define __GDS_ARRAY_DEF_ALLOW__
 #include "def/gds_array_def.h"
@@ -25,6 +38,130 @@ static void _gds_array_shift_right(GDSArray* array, size_t start_idx);
  * This function assumes that it will not receive a NULL pointer as 'array' argument, and that 'start_idx' < array's count. */
 static void _gds_array_shift_left(GDSArray* array, size_t start_idx);
 
+// ---------------------------------------------------------------------------------------------------------------------
+
+#ifdef __linux__
+/* Returns the size of the mapping needed to hold 'bytes' bytes for GDS_ARR_STORAGE_HUGE arrays - 'bytes' rounded up to
+ * the page size, or to GDS_ARR_HUGE_PAGE_SIZE if at least GDS_ARR_HUGE_PAGE_THRESHOLD. */
+static size_t _gds_array_huge_mapping_size(size_t bytes);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Marks the mapping of a GDS_ARR_STORAGE_HUGE array with MADV_HUGEPAGE, if it is large enough. Failure is ignored -
+ * transparent huge pages may be disabled on the system, in which case the mapping is simply backed by regular pages. */
+static void _gds_array_huge_advise(GDSArray* array);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Resizes the mapping of a GDS_ARR_STORAGE_HUGE array to fit 'new_capacity' elements with mremap(). Updates '_data',
+ * '_mapped_size' and '_capacity'. Assumes non-NULL 'array' and that the array's count fits 'new_capacity'. */
+static gds_err _gds_array_huge_remap(GDSArray* array, size_t new_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Header at the start of files backing GDS_ARR_STORAGE_FILE arrays. Padded to GDS_ARR_FILE_HEADER_SIZE bytes. */
+struct _GDSArrayFileHeader
+{
+    char magic[8]; // _GDS_ARRAY_FILE_MAGIC,
+    uint32_t version; // GDS_ARR_FILE_VERSION,
+    uint32_t header_size; // GDS_ARR_FILE_HEADER_SIZE,
+    uint64_t element_size;
+    uint64_t count; // count of elements, as of the last gds_array_flush() or gds_array_destruct().
+};
+
+#define _GDS_ARRAY_FILE_MAGIC "GDSARRAY"
+
+/* Returns the header of the file mapped by a GDS_ARR_STORAGE_FILE array. Assumes non-NULL 'array'. */
+static struct _GDSArrayFileHeader* _gds_array_file_header(const GDSArray* array);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Resizes the backing file and the mapping of a GDS_ARR_STORAGE_FILE array to fit 'new_capacity' elements.
+ * Updates '_data', '_mapped_size' and '_capacity'. Assumes non-NULL 'array' and that the array's count fits
+ * 'new_capacity'. */
+static gds_err _gds_array_file_remap(GDSArray* array, size_t new_capacity);
+#endif // __linux__
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Releases the memory holding the array's data, according to the array's storage. For GDS_ARR_STORAGE_FILE arrays,
+ * the count is stored in the file's header and the file is closed. Assumes non-NULL 'array'. */
+static void _gds_array_release_storage(GDSArray* array);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Ranges with at most this many elements are sorted with insertion sort. */
+#define _GDS_ARRAY_SORT_INSERTION_THRESHOLD 16
+
+/* Ranges with more than this many elements choose their pivot with Tukey's ninther instead of a median of three. */
+#define _GDS_ARRAY_SORT_NINTHER_THRESHOLD 128
+
+/* Maximum number of element moves _gds_array_partial_insertion_sort() performs before giving up. */
+#define _GDS_ARRAY_SORT_PARTIAL_INSERTION_LIMIT 8
+
+typedef int (*_gds_array_compare_func)(const void*, const void*);
+
+/* Sorts 'count' elements of size 'size', starting at 'base'. 'depth_limit' is the number of partitioning levels left
+ * before the range is heapsorted instead - it drops by one on every level, balanced or not, and starts at
+ * 2 * log2(count), as in classic introsort. 'leftmost' is true if the range is the leftmost part of the array -
+ * otherwise, the element right before 'base' is known to be less than or equal to every element of the range. */
+static void _gds_array_introsort(char* base, size_t count, size_t size, _gds_array_compare_func compare_func,
+        size_t depth_limit, bool leftmost);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Partitions the range around the pivot located at 'base'. Elements less than the pivot are moved to the left,
+ * elements greater or equal to the pivot are moved to the right. The pivot is then moved in between. Returns the
+ * final index of the pivot. '*already_partitioned' is set to true if no elements had to be swapped. */
+static size_t _gds_array_partition_right(char* base, size_t count, size_t size, _gds_array_compare_func compare_func,
+        bool* already_partitioned);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as _gds_array_partition_right(), except that elements equal to the pivot are moved to the left. Used when the
+ * pivot is equal to the element preceding the range - all elements left of the returned index are then equal to the
+ * pivot and need no further sorting. */
+static size_t _gds_array_partition_left(char* base, size_t count, size_t size, _gds_array_compare_func compare_func);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs an insertion sort on the range, but gives up if more than _GDS_ARRAY_SORT_PARTIAL_INSERTION_LIMIT
+ * element moves are needed. Returns true if the range got sorted. */
+static bool _gds_array_partial_insertion_sort(char* base, size_t count, size_t size,
+        _gds_array_compare_func compare_func);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void _gds_array_insertion_sort(char* base, size_t count, size_t size, _gds_array_compare_func compare_func);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Orders the three elements so that *a <= *b <= *c. */
+static inline void _gds_array_sort3(char* a, char* b, char* c, size_t size, _gds_array_compare_func compare_func);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void _gds_array_heap_sift_down(char* base, size_t root, size_t count, size_t size,
+        _gds_array_compare_func compare_func);
+
+static void _gds_array_heap_sort(char* base, size_t count, size_t size, _gds_array_compare_func compare_func);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns digit(byte) 'digit' of the 'key_width' byte native-endian integer key at 'key', digit 0 being the least
+ * significant one. If 'key_signed' is true, the sign bit of the most significant digit is flipped so that negative
+ * keys are ordered before positive ones. */
+static inline size_t _gds_array_radix_digit(const unsigned char* key, size_t digit, size_t key_width, bool key_signed);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#ifdef __SSE2__
+/* Searches 'count' elements of size 'size'(2, 4, 8 or 16) starting at 'base' for the element equal to 'data'.
+ * Each iteration compares 64 bytes. Elements that don't fill a whole 16-byte block are compared one by one.
+ * Returns -1 if no element is found. */
+static ssize_t _gds_array_find_bytes_sse2(const char* base, size_t count, size_t size, const void* data);
+#endif // __SSE2__
+
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
 gds_err gds_array_init(GDSArray* array, size_t capacity, size_t element_size)
@@ -36,6 +173,9 @@ gds_err gds_array_init(GDSArray* array, size_t capacity, size_t element_size)
     array->_capacity = capacity;
     array->_element_size = element_size;
     array->_count = 0;
+    array->_storage = GDS_ARR_STORAGE_HEAP;
+    array->_mapped_size = 0;
+    array->_fd = -1;
 
     array->_data = malloc(capacity * element_size);
 
@@ -46,6 +186,150 @@ gds_err gds_array_init(GDSArray* array, size_t capacity, size_t element_size)
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+gds_err gds_array_init_huge(GDSArray* array, size_t capacity, size_t element_size)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(capacity == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+#ifdef __linux__
+    size_t mapped_size = _gds_array_huge_mapping_size(capacity * element_size);
+
+    void* data = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(data == MAP_FAILED) return GDS_ARR_ERR_MMAP_FAIL;
+
+    array->_data = data;
+    array->_mapped_size = mapped_size;
+    array->_capacity = mapped_size / element_size;
+    array->_element_size = element_size;
+    array->_count = 0;
+    array->_storage = GDS_ARR_STORAGE_HUGE;
+    array->_fd = -1;
+
+    _gds_array_huge_advise(array);
+
+    return GDS_SUCCESS;
+#else
+    return GDS_ARR_ERR_STORAGE_UNSUPPORTED;
+#endif // __linux__
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_array_init_file(GDSArray* array, const char* path, size_t capacity, size_t element_size)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(path == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(capacity == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+#ifdef __linux__
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(fd < 0) return GDS_ARR_ERR_FILE_OPEN_FAIL;
+
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) != 0)
+    {
+        close(fd);
+        return GDS_ARR_ERR_FILE_OPEN_FAIL;
+    }
+
+    size_t file_size = (size_t)file_stat.st_size;
+    size_t count = 0;
+    bool is_new = (file_size == 0);
+
+    if(is_new)
+    {
+        if(element_size == 0)
+        {
+            close(fd);
+            return GDS_GEN_ERR_INVALID_ARG(4);
+        }
+    }
+    else
+    {
+        struct _GDSArrayFileHeader header;
+
+        if((file_size < GDS_ARR_FILE_HEADER_SIZE) ||
+                (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) ||
+                (memcmp(header.magic, _GDS_ARRAY_FILE_MAGIC, sizeof(header.magic)) != 0) ||
+                (header.version != GDS_ARR_FILE_VERSION) ||
+                (header.header_size != GDS_ARR_FILE_HEADER_SIZE) ||
+                (header.element_size == 0) ||
+                ((element_size != 0) && (header.element_size != element_size)) ||
+                (header.count > (file_size - GDS_ARR_FILE_HEADER_SIZE) / header.element_size))
+        {
+            close(fd);
+            return GDS_ARR_ERR_FILE_INVALID;
+        }
+
+        element_size = header.element_size;
+        count = header.count;
+
+        // keep any capacity the file already has.
+        size_t file_capacity = (file_size - GDS_ARR_FILE_HEADER_SIZE) / element_size;
+        if(capacity < file_capacity) capacity = file_capacity;
+    }
+
+    size_t mapped_size = GDS_ARR_FILE_HEADER_SIZE + (capacity * element_size);
+
+    if((file_size < mapped_size) && (ftruncate(fd, mapped_size) != 0))
+    {
+        close(fd);
+        return GDS_ARR_ERR_FILE_OPEN_FAIL;
+    }
+
+    char* map = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(map == MAP_FAILED)
+    {
+        close(fd);
+        return GDS_ARR_ERR_MMAP_FAIL;
+    }
+
+    array->_data = map + GDS_ARR_FILE_HEADER_SIZE;
+    array->_mapped_size = mapped_size;
+    array->_capacity = capacity;
+    array->_element_size = element_size;
+    array->_count = count;
+    array->_storage = GDS_ARR_STORAGE_FILE;
+    array->_fd = fd;
+
+    if(is_new)
+    {
+        struct _GDSArrayFileHeader* header = _gds_array_file_header(array);
+
+        memcpy(header->magic, _GDS_ARRAY_FILE_MAGIC, sizeof(header->magic));
+        header->version = GDS_ARR_FILE_VERSION;
+        header->header_size = GDS_ARR_FILE_HEADER_SIZE;
+        header->element_size = element_size;
+        header->count = 0;
+    }
+
+    return GDS_SUCCESS;
+#else
+    return GDS_ARR_ERR_STORAGE_UNSUPPORTED;
+#endif // __linux__
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_array_flush(GDSArray* array)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+#ifdef __linux__
+    if(array->_storage != GDS_ARR_STORAGE_FILE) return GDS_SUCCESS;
+
+    struct _GDSArrayFileHeader* header = _gds_array_file_header(array);
+    header->count = array->_count;
+
+    if(msync(header, array->_mapped_size, MS_SYNC) != 0) return GDS_ARR_ERR_SYNC_FAIL;
+#endif // __linux__
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 GDSArray* gds_array_create(size_t capacity, size_t element_size)
 {
     if((capacity == 0) || (element_size == 0)) return NULL;
@@ -69,12 +353,18 @@ void gds_array_destruct(GDSArray* array)
 {
     if(array == NULL) return;
 
-    gds_array_empty(array);
-    free(array->_data);
+    // the elements of a file-backed array are persistent - they stay in the file.
+    if(array->_storage != GDS_ARR_STORAGE_FILE) gds_array_empty(array);
+
+    _gds_array_release_storage(array);
 
+    array->_data = NULL;
     array->_count = 0;
     array->_capacity = 0;
     array->_element_size = 0;
+    array->_storage = GDS_ARR_STORAGE_HEAP;
+    array->_mapped_size = 0;
+    array->_fd = -1;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -200,13 +490,18 @@ gds_err gds_array_realloc(GDSArray* array, size_t new_capacity)
 
     while(new_capacity < array->_count) gds_array_pop_back(array); // shrink the array.
 
+#ifdef __linux__
+    if(array->_storage == GDS_ARR_STORAGE_HUGE) return _gds_array_huge_remap(array, new_capacity);
+    if(array->_storage == GDS_ARR_STORAGE_FILE) return _gds_array_file_remap(array, new_capacity);
+#endif // __linux__
+
     void* realloc_status = realloc(array->_data, new_capacity * array->_element_size);
 
     if(realloc_status == NULL) return GDS_ARR_ERR_REALLOC_FAIL;
     else array->_data = realloc_status;
 
     array->_capacity = new_capacity;
-    array->_count = gds_misc_min(array->_count, array->_capacity);
+    if(array->_count > array->_capacity) array->_count = array->_capacity;
 
     return GDS_SUCCESS;
 }
@@ -219,14 +514,51 @@ ssize_t gds_array_find(GDSArray* array, const void* data, bool (*compare_func)(c
     if(data == NULL) return -1;
     if(compare_func == NULL) return -1;
 
-    size_t array_count = gds_array_get_count(array);
+    size_t array_count = array->_count;
+    size_t element_size = array->_element_size;
 
     size_t i;
-    void* curr_element;
+    const char* curr_element = array->_data;
     for(i = 0; i < array_count; i++)
     {
-        curr_element = gds_array_at(array, i);
         if(compare_func(curr_element, data) == 0) return i;
+        curr_element += element_size;
+    }
+
+    return -1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ssize_t gds_array_find_bytes(const GDSArray* array, const void* data)
+{
+    if(array == NULL) return -1;
+    if(data == NULL) return -1;
+
+    size_t count = array->_count;
+    size_t size = array->_element_size;
+    const char* base = array->_data;
+
+    if(count == 0) return -1;
+
+    if(size == 1)
+    {
+        const char* found = memchr(base, *(const unsigned char*)data, count);
+        return (found != NULL) ? (found - base) : -1;
+    }
+
+#ifdef __SSE2__
+    if((size == 2) || (size == 4) || (size == 8) || (size == 16))
+        return _gds_array_find_bytes_sse2(base, count, size, data);
+#endif // __SSE2__
+
+    size_t i;
+    const char* curr_element = base;
+    unsigned char first_byte = *(const unsigned char*)data;
+    for(i = 0; i < count; i++)
+    {
+        if((*(const unsigned char*)curr_element == first_byte) && (memcmp(curr_element, data, size) == 0)) return i;
+        curr_element += size;
     }
 
     return -1;
@@ -234,6 +566,97 @@ ssize_t gds_array_find(GDSArray* array, const void* data, bool (*compare_func)(c
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+gds_err gds_array_sort(GDSArray* array, int (*compare_func)(const void*, const void*))
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t count = array->_count;
+    if(count < 2) return GDS_SUCCESS;
+
+    size_t depth_limit = 0;
+    size_t i;
+    for(i = count; i > 1; i >>= 1) depth_limit += 2;
+
+    _gds_array_introsort(array->_data, count, array->_element_size, compare_func, depth_limit, true);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_array_radix_sort(GDSArray* array, size_t key_offset, size_t key_width, bool key_signed)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if((key_width == 0) || (key_width > 8)) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(key_offset + key_width > array->_element_size) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    size_t count = array->_count;
+    size_t size = array->_element_size;
+    if(count < 2) return GDS_SUCCESS;
+
+    size_t* histograms = (size_t*)calloc(key_width * 256, sizeof(size_t));
+    if(histograms == NULL) return GDS_ARR_ERR_MALLOC_FAIL;
+
+    char* scratch = (char*)malloc(count * size);
+    if(scratch == NULL)
+    {
+        free(histograms);
+        return GDS_ARR_ERR_MALLOC_FAIL;
+    }
+
+    char* src = array->_data;
+    char* dst = scratch;
+
+    size_t i, d;
+    const unsigned char* key;
+    for(i = 0; i < count; i++)
+    {
+        key = (const unsigned char*)(src + (i * size) + key_offset);
+        for(d = 0; d < key_width; d++)
+            histograms[(d * 256) + _gds_array_radix_digit(key, d, key_width, key_signed)]++;
+    }
+
+    size_t* histogram;
+    size_t offset, bucket_count;
+    char* tmp;
+    for(d = 0; d < key_width; d++)
+    {
+        histogram = histograms + (d * 256);
+
+        // every key has the same digit - the pass would not change the order of elements.
+        if(histogram[_gds_array_radix_digit((const unsigned char*)(src + key_offset), d, key_width, key_signed)] == count)
+            continue;
+
+        offset = 0;
+        for(i = 0; i < 256; i++)
+        {
+            bucket_count = histogram[i];
+            histogram[i] = offset;
+            offset += bucket_count;
+        }
+
+        for(i = 0; i < count; i++)
+        {
+            key = (const unsigned char*)(src + (i * size) + key_offset);
+            memcpy(dst + (histogram[_gds_array_radix_digit(key, d, key_width, key_signed)]++ * size), src + (i * size), size);
+        }
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if(src != array->_data) memcpy(array->_data, src, count * size);
+
+    free(scratch);
+    free(histograms);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 size_t gds_array_get_count(const GDSArray* array)
 {
     return (array != NULL) ? array->_count : 0;
@@ -262,6 +685,13 @@ size_t gds_array_get_element_size(const GDSArray* array)
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+int gds_array_get_storage(const GDSArray* array)
+{
+    return (array != NULL) ? array->_storage : GDS_ARR_STORAGE_HEAP;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 size_t gds_array_get_struct_size()
 {
     return sizeof(GDSArray);
@@ -293,4 +723,393 @@ static void _gds_array_shift_left(GDSArray* array, size_t start_idx)
     memmove(start_pos, start_pos + step, step * elements_shifted);
 }
 
+#ifdef __linux__
+static size_t _gds_array_huge_mapping_size(size_t bytes)
+{
+    size_t granularity = (bytes >= GDS_ARR_HUGE_PAGE_THRESHOLD) ? GDS_ARR_HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+
+    return ((bytes + granularity - 1) / granularity) * granularity;
+}
+
+static void _gds_array_huge_advise(GDSArray* array)
+{
+#ifdef MADV_HUGEPAGE
+    if(array->_mapped_size >= GDS_ARR_HUGE_PAGE_THRESHOLD)
+        madvise(array->_data, array->_mapped_size, MADV_HUGEPAGE);
+#else
+    (void)array;
+#endif // MADV_HUGEPAGE
+}
+
+static gds_err _gds_array_huge_remap(GDSArray* array, size_t new_capacity)
+{
+    size_t new_mapped_size = _gds_array_huge_mapping_size(new_capacity * array->_element_size);
+
+    if(new_mapped_size != array->_mapped_size)
+    {
+        // MREMAP_MAYMOVE lets the kernel relocate the mapping if it can't be extended in place. Only page table
+        // entries are moved in that case - the data isn't copied.
+        void* data = mremap(array->_data, array->_mapped_size, new_mapped_size, MREMAP_MAYMOVE);
+        if(data == MAP_FAILED) return GDS_ARR_ERR_REALLOC_FAIL;
+
+        array->_data = data;
+        array->_mapped_size = new_mapped_size;
+
+        _gds_array_huge_advise(array);
+    }
+
+    array->_capacity = new_mapped_size / array->_element_size;
 
+    return GDS_SUCCESS;
+}
+
+static struct _GDSArrayFileHeader* _gds_array_file_header(const GDSArray* array)
+{
+    return (struct _GDSArrayFileHeader*)((char*)array->_data - GDS_ARR_FILE_HEADER_SIZE);
+}
+
+static gds_err _gds_array_file_remap(GDSArray* array, size_t new_capacity)
+{
+    size_t new_mapped_size = GDS_ARR_FILE_HEADER_SIZE + (new_capacity * array->_element_size);
+    size_t old_mapped_size = array->_mapped_size;
+    void* map = _gds_array_file_header(array);
+
+    // the file must be extended before the mapping, so that the new pages are backed by it.
+    if((new_mapped_size > old_mapped_size) && (ftruncate(array->_fd, new_mapped_size) != 0))
+        return GDS_ARR_ERR_REALLOC_FAIL;
+
+    void* new_map = mremap(map, old_mapped_size, new_mapped_size, MREMAP_MAYMOVE);
+    if(new_map == MAP_FAILED)
+    {
+        if(new_mapped_size > old_mapped_size) ftruncate(array->_fd, old_mapped_size);
+        return GDS_ARR_ERR_REALLOC_FAIL;
+    }
+
+    if(new_mapped_size < old_mapped_size) ftruncate(array->_fd, new_mapped_size);
+
+    array->_data = (char*)new_map + GDS_ARR_FILE_HEADER_SIZE;
+    array->_mapped_size = new_mapped_size;
+    array->_capacity = new_capacity;
+
+    return GDS_SUCCESS;
+}
+#endif // __linux__
+
+static void _gds_array_release_storage(GDSArray* array)
+{
+#ifdef __linux__
+    if(array->_storage == GDS_ARR_STORAGE_HUGE)
+    {
+        munmap(array->_data, array->_mapped_size);
+        return;
+    }
+    else if(array->_storage == GDS_ARR_STORAGE_FILE)
+    {
+        struct _GDSArrayFileHeader* header = _gds_array_file_header(array);
+        header->count = array->_count;
+
+        munmap(header, array->_mapped_size);
+        close(array->_fd);
+        return;
+    }
+#endif // __linux__
+
+    free(array->_data);
+}
+
+#ifdef __SSE2__
+static ssize_t _gds_array_find_bytes_sse2(const char* base, size_t count, size_t size, const void* data)
+{
+    // broadcast the searched value to all lanes of a 16-byte register.
+    __m128i needle;
+    uint16_t v16;
+    uint32_t v32;
+    uint64_t v64;
+    switch(size)
+    {
+        case 2:
+            memcpy(&v16, data, 2);
+            needle = _mm_set1_epi16((short)v16);
+            break;
+        case 4:
+            memcpy(&v32, data, 4);
+            needle = _mm_set1_epi32((int)v32);
+            break;
+        case 8:
+            memcpy(&v64, data, 8);
+            needle = _mm_set1_epi64x((long long)v64);
+            break;
+        default:
+            needle = _mm_loadu_si128((const __m128i*)data);
+            break;
+    }
+
+    // one movemask bit per element - the bit of its first byte.
+    unsigned int lane_mask = (size == 2) ? 0x5555 : ((size == 4) ? 0x1111 : ((size == 8) ? 0x0101 : 0x0001));
+
+    size_t total_bytes = count * size;
+    size_t i = 0;
+    __m128i c0, c1, c2, c3;
+    unsigned int mask, matches, block;
+
+    for(; i + 64 <= total_bytes; i += 64)
+    {
+        if(size == 2)
+        {
+            c0 = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(base + i)), needle);
+            c1 = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(base + i + 16)), needle);
+            c2 = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(base + i + 32)), needle);
+            c3 = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(base + i + 48)), needle);
+        }
+        else if(size == 4)
+        {
+            c0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i)), needle);
+            c1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i + 16)), needle);
+            c2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i + 32)), needle);
+            c3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i + 48)), needle);
+        }
+        else
+        {
+            // 8 and 16-byte elements are compared per 4-byte word - an element matches if all of its words do.
+            c0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i)), needle);
+            c1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i + 16)), needle);
+            c2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i + 32)), needle);
+            c3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(base + i + 48)), needle);
+        }
+
+        if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3))) == 0) continue;
+
+        __m128i blocks[4] = { c0, c1, c2, c3 };
+        for(block = 0; block < 4; block++)
+        {
+            mask = (unsigned int)_mm_movemask_epi8(blocks[block]);
+
+            // keep the first bit of each element only if all of the element's 4-byte words matched.
+            matches = mask;
+            if(size >= 8) matches &= (matches >> 4);
+            if(size == 16) matches &= (matches >> 8);
+            matches &= lane_mask;
+
+            if(matches != 0) return (i + (block * 16) + __builtin_ctz(matches)) / size;
+        }
+    }
+
+    for(; i < total_bytes; i += size)
+    {
+        if(memcmp(base + i, data, size) == 0) return i / size;
+    }
+
+    return -1;
+}
+#endif // __SSE2__
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void _gds_array_introsort(char* base, size_t count, size_t size, _gds_array_compare_func compare_func,
+        size_t depth_limit, bool leftmost)
+{
+    size_t mid, last, pivot_pos, left_count, right_count;
+    bool already_partitioned;
+
+    while(count > _GDS_ARRAY_SORT_INSERTION_THRESHOLD)
+    {
+        if(depth_limit == 0)
+        {
+            _gds_array_heap_sort(base, count, size, compare_func);
+            return;
+        }
+        depth_limit--;
+
+        // move the chosen pivot to 'base'.
+        mid = count / 2;
+        last = count - 1;
+        if(count > _GDS_ARRAY_SORT_NINTHER_THRESHOLD)
+        {
+            _gds_array_sort3(base, base + (mid * size), base + (last * size), size, compare_func);
+            _gds_array_sort3(base + size, base + ((mid - 1) * size), base + ((last - 1) * size), size, compare_func);
+            _gds_array_sort3(base + (2 * size), base + ((mid + 1) * size), base + ((last - 2) * size), size, compare_func);
+            _gds_array_sort3(base + ((mid - 1) * size), base + (mid * size), base + ((mid + 1) * size), size, compare_func);
+            gds_misc_swap_inplace(base, base + (mid * size), size);
+        }
+        else _gds_array_sort3(base + (mid * size), base, base + (last * size), size, compare_func);
+
+        // the pivot is equal to the preceding element, which is not greater than any element of the range. Elements
+        // equal to the pivot are grouped on the left and never need to be looked at again.
+        if(!leftmost && (compare_func(base - size, base) >= 0))
+        {
+            pivot_pos = _gds_array_partition_left(base, count, size, compare_func);
+            base += (pivot_pos + 1) * size;
+            count -= pivot_pos + 1;
+            continue;
+        }
+
+        pivot_pos = _gds_array_partition_right(base, count, size, compare_func, &already_partitioned);
+        left_count = pivot_pos;
+        right_count = count - pivot_pos - 1;
+
+        if(already_partitioned &&
+                _gds_array_partial_insertion_sort(base, left_count, size, compare_func) &&
+                _gds_array_partial_insertion_sort(base + ((pivot_pos + 1) * size), right_count, size, compare_func))
+            return;
+
+        // recurse into the smaller part, loop on the larger one - this bounds the stack depth to O(log n).
+        if(left_count < right_count)
+        {
+            _gds_array_introsort(base, left_count, size, compare_func, depth_limit, leftmost);
+            base += (pivot_pos + 1) * size;
+            count = right_count;
+            leftmost = false;
+        }
+        else
+        {
+            _gds_array_introsort(base + ((pivot_pos + 1) * size), right_count, size, compare_func, depth_limit, false);
+            count = left_count;
+        }
+    }
+
+    _gds_array_insertion_sort(base, count, size, compare_func);
+}
+
+static size_t _gds_array_partition_right(char* base, size_t count, size_t size, _gds_array_compare_func compare_func,
+        bool* already_partitioned)
+{
+    char* pivot = base;
+    char* lo = base + size;
+    char* hi = base + ((count - 1) * size);
+
+    *already_partitioned = true;
+
+    while(true)
+    {
+        while((lo <= hi) && (compare_func(lo, pivot) < 0)) lo += size;
+        while((lo <= hi) && (compare_func(hi, pivot) >= 0)) hi -= size;
+
+        if(lo > hi) break;
+
+        gds_misc_swap_inplace(lo, hi, size);
+        *already_partitioned = false;
+        lo += size;
+        hi -= size;
+    }
+
+    char* pivot_pos = lo - size;
+    if(pivot_pos != base) gds_misc_swap_inplace(base, pivot_pos, size);
+
+    return (pivot_pos - base) / size;
+}
+
+static size_t _gds_array_partition_left(char* base, size_t count, size_t size, _gds_array_compare_func compare_func)
+{
+    char* pivot = base;
+    char* lo = base + size;
+    char* hi = base + ((count - 1) * size);
+
+    while(true)
+    {
+        while((lo <= hi) && (compare_func(pivot, lo) >= 0)) lo += size;
+        while((lo <= hi) && (compare_func(pivot, hi) < 0)) hi -= size;
+
+        if(lo > hi) break;
+
+        gds_misc_swap_inplace(lo, hi, size);
+        lo += size;
+        hi -= size;
+    }
+
+    char* pivot_pos = lo - size;
+    if(pivot_pos != base) gds_misc_swap_inplace(base, pivot_pos, size);
+
+    return (pivot_pos - base) / size;
+}
+
+static bool _gds_array_partial_insertion_sort(char* base, size_t count, size_t size,
+        _gds_array_compare_func compare_func)
+{
+    size_t moves = 0;
+    size_t i;
+    char* it;
+
+    for(i = 1; i < count; i++)
+    {
+        it = base + (i * size);
+        if(compare_func(it - size, it) <= 0) continue;
+
+        do
+        {
+            gds_misc_swap_inplace(it - size, it, size);
+            it -= size;
+            moves++;
+        } while((it > base) && (compare_func(it - size, it) > 0));
+
+        if(moves > _GDS_ARRAY_SORT_PARTIAL_INSERTION_LIMIT) return false;
+    }
+
+    return true;
+}
+
+static void _gds_array_insertion_sort(char* base, size_t count, size_t size, _gds_array_compare_func compare_func)
+{
+    size_t i;
+    char* it;
+
+    for(i = 1; i < count; i++)
+    {
+        it = base + (i * size);
+        while((it > base) && (compare_func(it - size, it) > 0))
+        {
+            gds_misc_swap_inplace(it - size, it, size);
+            it -= size;
+        }
+    }
+}
+
+static inline void _gds_array_sort3(char* a, char* b, char* c, size_t size, _gds_array_compare_func compare_func)
+{
+    if(compare_func(a, b) > 0) gds_misc_swap_inplace(a, b, size);
+    if(compare_func(b, c) > 0)
+    {
+        gds_misc_swap_inplace(b, c, size);
+        if(compare_func(a, b) > 0) gds_misc_swap_inplace(a, b, size);
+    }
+}
+
+static void _gds_array_heap_sift_down(char* base, size_t root, size_t count, size_t size,
+        _gds_array_compare_func compare_func)
+{
+    size_t child;
+
+    while((child = (2 * root) + 1) < count)
+    {
+        if((child + 1 < count) && (compare_func(base + (child * size), base + ((child + 1) * size)) < 0)) child++;
+        if(compare_func(base + (root * size), base + (child * size)) >= 0) return;
+
+        gds_misc_swap_inplace(base + (root * size), base + (child * size), size);
+        root = child;
+    }
+}
+
+static void _gds_array_heap_sort(char* base, size_t count, size_t size, _gds_array_compare_func compare_func)
+{
+    size_t i;
+
+    for(i = count / 2; i > 0; i--) _gds_array_heap_sift_down(base, i - 1, count, size, compare_func);
+
+    for(i = count - 1; i > 0; i--)
+    {
+        gds_misc_swap_inplace(base, base + (i * size), size);
+        _gds_array_heap_sift_down(base, 0, i, size, compare_func);
+    }
+}
+
+static inline size_t _gds_array_radix_digit(const unsigned char* key, size_t digit, size_t key_width, bool key_signed)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    size_t value = key[key_width - 1 - digit];
+#else
+    size_t value = key[digit];
+#endif
+
+    if(key_signed && (digit == key_width - 1)) value ^= 0x80;
+
+    return value;
+}
@@ -0,0 +1,490 @@
+#include "gds.h"
+#include "gds_bitset.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_BITSET_DEF_ALLOW__
+#include "def/gds_bitset_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+/* On x86-64, __builtin_popcountll() only becomes the POPCNT instruction if the code is compiled for it. Functions
+ * that count bits are cloned - one clone uses POPCNT, the other doesn't, and the right one is picked at load time. */
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__) && !defined(__POPCNT__)
+#define _GDS_BITSET_POPCNT_CLONES __attribute__((target_clones("popcnt", "default")))
+#else
+#define _GDS_BITSET_POPCNT_CLONES
+#endif
+
+#define _GDS_BITSET_WORD_BITS 64
+
+#define _GDS_BITSET_OP_AND 0
+#define _GDS_BITSET_OP_OR 1
+#define _GDS_BITSET_OP_XOR 2
+#define _GDS_BITSET_OP_ANDNOT 3
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of words needed to hold 'bit_count' bits. */
+static inline size_t _gds_bitset_word_count(size_t bit_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Sets the unused bits of the last word to 0. Assumes non-NULL 'bitset'. */
+static inline void _gds_bitset_clear_tail(GDSBitset* bitset);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of bits set to 1 in the first 'word_count' words of 'words'. */
+static size_t _gds_bitset_popcount(const uint64_t* words, size_t word_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Finds the word containing the bit with rank 'rank'. Stores the word's index into 'word_index' and the rank of the
+ * bit within that word into 'rank_in_word'.
+ * Return value: true if the bit exists, false otherwise. */
+static bool _gds_bitset_select_word(const uint64_t* words, size_t word_count, size_t rank, size_t* word_index,
+        size_t* rank_in_word);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Performs one of the _GDS_BITSET_OP_* operations on all words of 'dest' and 'src'. */
+static gds_err _gds_bitset_bulk(GDSBitset* dest, const GDSBitset* src, int op);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_init(GDSBitset* bitset, size_t bit_count)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    size_t word_count = _gds_bitset_word_count(bit_count);
+    size_t word_capacity = (word_count > 0) ? word_count : 1;
+
+    bitset->_words = (uint64_t*)calloc(word_capacity, sizeof(uint64_t));
+    if(bitset->_words == NULL) return GDS_BITSET_ERR_MALLOC_FAIL;
+
+    bitset->_bit_count = bit_count;
+    bitset->_word_capacity = word_capacity;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSBitset* gds_bitset_create(size_t bit_count)
+{
+    GDSBitset* bitset = (GDSBitset*)malloc(sizeof(GDSBitset));
+    if(bitset == NULL) return NULL;
+
+    gds_err init_status = gds_bitset_init(bitset, bit_count);
+
+    if(init_status == GDS_SUCCESS) return bitset;
+    else
+    {
+        free(bitset);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_bitset_destruct(GDSBitset* bitset)
+{
+    if(bitset == NULL) return;
+
+    free(bitset->_words);
+
+    bitset->_words = NULL;
+    bitset->_bit_count = 0;
+    bitset->_word_capacity = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_set(GDSBitset* bitset, size_t pos)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= bitset->_bit_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    bitset->_words[pos / _GDS_BITSET_WORD_BITS] |= (uint64_t)1 << (pos % _GDS_BITSET_WORD_BITS);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_clear(GDSBitset* bitset, size_t pos)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= bitset->_bit_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    bitset->_words[pos / _GDS_BITSET_WORD_BITS] &= ~((uint64_t)1 << (pos % _GDS_BITSET_WORD_BITS));
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_flip(GDSBitset* bitset, size_t pos)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= bitset->_bit_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    bitset->_words[pos / _GDS_BITSET_WORD_BITS] ^= (uint64_t)1 << (pos % _GDS_BITSET_WORD_BITS);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_assign(GDSBitset* bitset, size_t pos, bool value)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= bitset->_bit_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    uint64_t mask = (uint64_t)1 << (pos % _GDS_BITSET_WORD_BITS);
+    uint64_t* word = &bitset->_words[pos / _GDS_BITSET_WORD_BITS];
+
+    *word = (*word & ~mask) | (-(uint64_t)value & mask);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_bitset_test(const GDSBitset* bitset, size_t pos)
+{
+    if(bitset == NULL) return false;
+    if(pos >= bitset->_bit_count) return false;
+
+    return (bitset->_words[pos / _GDS_BITSET_WORD_BITS] >> (pos % _GDS_BITSET_WORD_BITS)) & 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_set_all(GDSBitset* bitset)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    memset(bitset->_words, 0xFF, _gds_bitset_word_count(bitset->_bit_count) * sizeof(uint64_t));
+    _gds_bitset_clear_tail(bitset);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_clear_all(GDSBitset* bitset)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    memset(bitset->_words, 0, _gds_bitset_word_count(bitset->_bit_count) * sizeof(uint64_t));
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_resize(GDSBitset* bitset, size_t new_bit_count)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    size_t old_word_count = _gds_bitset_word_count(bitset->_bit_count);
+    size_t new_word_count = _gds_bitset_word_count(new_bit_count);
+
+    if(new_word_count > bitset->_word_capacity)
+    {
+        size_t new_capacity = bitset->_word_capacity * 2;
+        if(new_capacity < new_word_count) new_capacity = new_word_count;
+
+        uint64_t* new_words = (uint64_t*)realloc(bitset->_words, new_capacity * sizeof(uint64_t));
+        if(new_words == NULL) return GDS_BITSET_ERR_REALLOC_FAIL;
+
+        bitset->_words = new_words;
+        bitset->_word_capacity = new_capacity;
+    }
+
+    // words that come into use are zeroed. When shrinking, the cut-off bits of the new last word are cleared below.
+    if(new_word_count > old_word_count)
+        memset(bitset->_words + old_word_count, 0, (new_word_count - old_word_count) * sizeof(uint64_t));
+
+    bitset->_bit_count = new_bit_count;
+    _gds_bitset_clear_tail(bitset);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_push_back(GDSBitset* bitset, bool value)
+{
+    if(bitset == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    gds_err resize_status = gds_bitset_resize(bitset, bitset->_bit_count + 1);
+    if(resize_status != GDS_SUCCESS) return resize_status;
+
+    if(value) gds_bitset_set(bitset, bitset->_bit_count - 1);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_bitset_count(const GDSBitset* bitset)
+{
+    if(bitset == NULL) return 0;
+
+    return _gds_bitset_popcount(bitset->_words, _gds_bitset_word_count(bitset->_bit_count));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_bitset_rank(const GDSBitset* bitset, size_t pos)
+{
+    if(bitset == NULL) return 0;
+    if(pos > bitset->_bit_count) return 0;
+
+    size_t full_word_count = pos / _GDS_BITSET_WORD_BITS;
+    size_t rank = _gds_bitset_popcount(bitset->_words, full_word_count);
+
+    size_t remaining_bits = pos % _GDS_BITSET_WORD_BITS;
+    if(remaining_bits > 0)
+    {
+        uint64_t last = bitset->_words[full_word_count] & (((uint64_t)1 << remaining_bits) - 1);
+        rank += _gds_bitset_popcount(&last, 1);
+    }
+
+    return rank;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ssize_t gds_bitset_select(const GDSBitset* bitset, size_t rank)
+{
+    if(bitset == NULL) return -1;
+
+    size_t word_index, rank_in_word;
+    if(!_gds_bitset_select_word(bitset->_words, _gds_bitset_word_count(bitset->_bit_count), rank,
+                &word_index, &rank_in_word))
+        return -1;
+
+    // drop the lowest set bits until the wanted one is the lowest.
+    uint64_t word = bitset->_words[word_index];
+    while(rank_in_word > 0)
+    {
+        word &= word - 1;
+        rank_in_word--;
+    }
+
+    return (ssize_t)((word_index * _GDS_BITSET_WORD_BITS) + __builtin_ctzll(word));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ssize_t gds_bitset_find_first_set(const GDSBitset* bitset, size_t from)
+{
+    if(bitset == NULL) return -1;
+    if(from >= bitset->_bit_count) return -1;
+
+    size_t word_count = _gds_bitset_word_count(bitset->_bit_count);
+    size_t word_index = from / _GDS_BITSET_WORD_BITS;
+    uint64_t word = bitset->_words[word_index] & (~(uint64_t)0 << (from % _GDS_BITSET_WORD_BITS));
+
+    while(word == 0)
+    {
+        word_index++;
+        if(word_index >= word_count) return -1;
+        word = bitset->_words[word_index];
+    }
+
+    return (ssize_t)((word_index * _GDS_BITSET_WORD_BITS) + __builtin_ctzll(word));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ssize_t gds_bitset_find_first_clear(const GDSBitset* bitset, size_t from)
+{
+    if(bitset == NULL) return -1;
+    if(from >= bitset->_bit_count) return -1;
+
+    size_t word_count = _gds_bitset_word_count(bitset->_bit_count);
+    size_t word_index = from / _GDS_BITSET_WORD_BITS;
+    uint64_t word = ~bitset->_words[word_index] & (~(uint64_t)0 << (from % _GDS_BITSET_WORD_BITS));
+
+    while(word == 0)
+    {
+        word_index++;
+        if(word_index >= word_count) return -1;
+        word = ~bitset->_words[word_index];
+    }
+
+    // the unused bits of the last word are 0, so they could be found here - they are out of bounds.
+    size_t pos = (word_index * _GDS_BITSET_WORD_BITS) + __builtin_ctzll(word);
+
+    return (pos < bitset->_bit_count) ? (ssize_t)pos : -1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_and(GDSBitset* dest, const GDSBitset* src)
+{
+    return _gds_bitset_bulk(dest, src, _GDS_BITSET_OP_AND);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_or(GDSBitset* dest, const GDSBitset* src)
+{
+    return _gds_bitset_bulk(dest, src, _GDS_BITSET_OP_OR);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_xor(GDSBitset* dest, const GDSBitset* src)
+{
+    return _gds_bitset_bulk(dest, src, _GDS_BITSET_OP_XOR);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_bitset_andnot(GDSBitset* dest, const GDSBitset* src)
+{
+    return _gds_bitset_bulk(dest, src, _GDS_BITSET_OP_ANDNOT);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t* gds_bitset_get_words(const GDSBitset* bitset)
+{
+    return (bitset != NULL) ? bitset->_words : NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_bitset_get_word_count(const GDSBitset* bitset)
+{
+    return (bitset != NULL) ? _gds_bitset_word_count(bitset->_bit_count) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_bitset_get_bit_count(const GDSBitset* bitset)
+{
+    return (bitset != NULL) ? bitset->_bit_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_bitset_get_struct_size()
+{
+    return sizeof(GDSBitset);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static inline size_t _gds_bitset_word_count(size_t bit_count)
+{
+    return (bit_count + _GDS_BITSET_WORD_BITS - 1) / _GDS_BITSET_WORD_BITS;
+}
+
+static inline void _gds_bitset_clear_tail(GDSBitset* bitset)
+{
+    size_t used_bits = bitset->_bit_count % _GDS_BITSET_WORD_BITS;
+    if(used_bits == 0) return;
+
+    bitset->_words[bitset->_bit_count / _GDS_BITSET_WORD_BITS] &= ((uint64_t)1 << used_bits) - 1;
+}
+
+_GDS_BITSET_POPCNT_CLONES
+static size_t _gds_bitset_popcount(const uint64_t* words, size_t word_count)
+{
+    // four independent sums, so consecutive popcounts don't wait on each other.
+    size_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    size_t i = 0;
+
+    for(; (i + 4) <= word_count; i += 4)
+    {
+        sum0 += __builtin_popcountll(words[i]);
+        sum1 += __builtin_popcountll(words[i + 1]);
+        sum2 += __builtin_popcountll(words[i + 2]);
+        sum3 += __builtin_popcountll(words[i + 3]);
+    }
+    for(; i < word_count; i++) sum0 += __builtin_popcountll(words[i]);
+
+    return sum0 + sum1 + sum2 + sum3;
+}
+
+_GDS_BITSET_POPCNT_CLONES
+static bool _gds_bitset_select_word(const uint64_t* words, size_t word_count, size_t rank, size_t* word_index,
+        size_t* rank_in_word)
+{
+    size_t i, word_rank;
+    for(i = 0; i < word_count; i++)
+    {
+        word_rank = __builtin_popcountll(words[i]);
+
+        if(rank < word_rank)
+        {
+            *word_index = i;
+            *rank_in_word = rank;
+            return true;
+        }
+
+        rank -= word_rank;
+    }
+
+    return false;
+}
+
+static gds_err _gds_bitset_bulk(GDSBitset* dest, const GDSBitset* src, int op)
+{
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(dest->_bit_count != src->_bit_count) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    size_t word_count = _gds_bitset_word_count(dest->_bit_count);
+    uint64_t* d = dest->_words;
+    const uint64_t* s = src->_words;
+    size_t i = 0;
+
+#ifdef __SSE2__
+/* Processes 4 words per iteration with two 128-bit operations. 'v' computes the new value of 'dst' from 'dst' and
+ * 'sv'. */
+#define _GDS_BITSET_SSE2_LOOP(v)                                                                                   \
+    for(; (i + 4) <= word_count; i += 4)                                                                           \
+    {                                                                                                              \
+        __m128i dst = _mm_loadu_si128((const __m128i*)(d + i));                                                    \
+        __m128i sv = _mm_loadu_si128((const __m128i*)(s + i));                                                     \
+        _mm_storeu_si128((__m128i*)(d + i), v);                                                                    \
+        dst = _mm_loadu_si128((const __m128i*)(d + i + 2));                                                        \
+        sv = _mm_loadu_si128((const __m128i*)(s + i + 2));                                                         \
+        _mm_storeu_si128((__m128i*)(d + i + 2), v);                                                                \
+    }
+
+    switch(op)
+    {
+        case _GDS_BITSET_OP_AND: _GDS_BITSET_SSE2_LOOP(_mm_and_si128(dst, sv)); break;
+        case _GDS_BITSET_OP_OR: _GDS_BITSET_SSE2_LOOP(_mm_or_si128(dst, sv)); break;
+        case _GDS_BITSET_OP_XOR: _GDS_BITSET_SSE2_LOOP(_mm_xor_si128(dst, sv)); break;
+        case _GDS_BITSET_OP_ANDNOT: _GDS_BITSET_SSE2_LOOP(_mm_andnot_si128(sv, dst)); break;
+    }
+
+#undef _GDS_BITSET_SSE2_LOOP
+#endif // __SSE2__
+
+    switch(op)
+    {
+        case _GDS_BITSET_OP_AND: for(; i < word_count; i++) d[i] &= s[i]; break;
+        case _GDS_BITSET_OP_OR: for(; i < word_count; i++) d[i] |= s[i]; break;
+        case _GDS_BITSET_OP_XOR: for(; i < word_count; i++) d[i] ^= s[i]; break;
+        case _GDS_BITSET_OP_ANDNOT: for(; i < word_count; i++) d[i] &= ~s[i]; break;
+    }
+
+    return GDS_SUCCESS;
+}
@@ -0,0 +1,377 @@
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_deque.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_DEQUE_DEF_ALLOW__
+#include "def/gds_deque_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Returns the smallest power of two that is greater or equal to 'capacity'. */
+static size_t _gds_deque_round_capacity(size_t capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the slot holding the element with index 'pos'. Assumes non-NULL 'deque'. 'pos' may be out of
+ * bounds(up to the deque's capacity), which is used to address free slots past the back of the deque. */
+static inline void* _gds_deque_slot(const GDSDeque* deque, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Grows the buffer so it can fit at least 'min_capacity' elements. After the realloc() call, the part of the
+ * sequence that wrapped around the end of the old buffer is moved, so that the sequence stays in order. The smaller
+ * of the two parts is the one that gets moved. Assumes non-NULL 'deque'. */
+static gds_err _gds_deque_grow(GDSDeque* deque, size_t min_capacity);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_init(GDSDeque* deque, size_t element_size, size_t initial_capacity)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(initial_capacity == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    deque->_head = 0;
+    deque->_count = 0;
+
+    gds_err init_status = gds_array_init(&deque->_data, _gds_deque_round_capacity(initial_capacity), element_size);
+
+    if(init_status == GDS_SUCCESS) return GDS_SUCCESS;
+    else if(init_status == GDS_ARR_ERR_MALLOC_FAIL) return GDS_DEQUE_ERR_MALLOC_FAIL;
+    else return GDS_GEN_ERR_INTERNAL_ERR;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSDeque* gds_deque_create(size_t element_size, size_t initial_capacity)
+{
+    GDSDeque* deque = (GDSDeque*)malloc(sizeof(GDSDeque));
+    if(deque == NULL) return NULL;
+
+    gds_err init_status = gds_deque_init(deque, element_size, initial_capacity);
+
+    if(init_status == GDS_SUCCESS) return deque;
+    else
+    {
+        free(deque);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_deque_destruct(GDSDeque* deque)
+{
+    if(deque == NULL) return;
+
+    gds_array_destruct(&deque->_data);
+
+    deque->_head = 0;
+    deque->_count = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_deque_at(const GDSDeque* deque, size_t pos)
+{
+    if(deque == NULL) return NULL;
+    if(pos >= deque->_count) return NULL;
+
+    return _gds_deque_slot(deque, pos);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_deque_front(const GDSDeque* deque)
+{
+    return gds_deque_at(deque, 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_deque_back(const GDSDeque* deque)
+{
+    if(deque == NULL) return NULL;
+    if(deque->_count == 0) return NULL;
+
+    return _gds_deque_slot(deque, deque->_count - 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_assign(GDSDeque* deque, const void* data, size_t pos)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos >= deque->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    memcpy(_gds_deque_slot(deque, pos), data, deque->_data._element_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_push_back(GDSDeque* deque, const void* data)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(deque->_count == deque->_data._capacity)
+    {
+        if(_gds_deque_grow(deque, deque->_count + 1) != GDS_SUCCESS) return GDS_DEQUE_ERR_REALLOC_FAIL;
+    }
+
+    memcpy(_gds_deque_slot(deque, deque->_count), data, deque->_data._element_size);
+    deque->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_push_front(GDSDeque* deque, const void* data)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(deque->_count == deque->_data._capacity)
+    {
+        if(_gds_deque_grow(deque, deque->_count + 1) != GDS_SUCCESS) return GDS_DEQUE_ERR_REALLOC_FAIL;
+    }
+
+    deque->_head = (deque->_head - 1) & (deque->_data._capacity - 1);
+    memcpy(_gds_deque_slot(deque, 0), data, deque->_data._element_size);
+    deque->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_push_back_n(GDSDeque* deque, const void* data, size_t count)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(deque->_count + count > deque->_data._capacity)
+    {
+        if(_gds_deque_grow(deque, deque->_count + count) != GDS_SUCCESS) return GDS_DEQUE_ERR_REALLOC_FAIL;
+    }
+
+    size_t capacity = deque->_data._capacity;
+    size_t element_size = deque->_data._element_size;
+    size_t tail = (deque->_head + deque->_count) & (capacity - 1);
+    size_t first_count = (count < capacity - tail) ? count : (capacity - tail);
+
+    memcpy((char*)deque->_data._data + (tail * element_size), data, first_count * element_size);
+    memcpy(deque->_data._data, (const char*)data + (first_count * element_size), (count - first_count) * element_size);
+
+    deque->_count += count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_pop_back(GDSDeque* deque)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(deque->_count == 0) return GDS_DEQUE_ERR_DEQUE_EMPTY;
+
+    deque->_count--;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_pop_front(GDSDeque* deque)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(deque->_count == 0) return GDS_DEQUE_ERR_DEQUE_EMPTY;
+
+    deque->_head = (deque->_head + 1) & (deque->_data._capacity - 1);
+    deque->_count--;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_pop_front_n(GDSDeque* deque, size_t count)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    if(count > deque->_count) count = deque->_count;
+
+    deque->_head = (deque->_head + count) & (deque->_data._capacity - 1);
+    deque->_count -= count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_get_segments(const GDSDeque* deque, void** first, size_t* first_count,
+        void** second, size_t* second_count)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(first == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(first_count == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(second == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(second_count == NULL) return GDS_GEN_ERR_INVALID_ARG(5);
+
+    size_t until_end = deque->_data._capacity - deque->_head;
+
+    *first = _gds_deque_slot(deque, 0);
+    if(deque->_count <= until_end)
+    {
+        *first_count = deque->_count;
+        *second = NULL;
+        *second_count = 0;
+    }
+    else
+    {
+        *first_count = until_end;
+        *second = deque->_data._data;
+        *second_count = deque->_count - until_end;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_copy_out(const GDSDeque* deque, void* dest, size_t pos, size_t count)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos > deque->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(count > deque->_count - pos) return GDS_GEN_ERR_INVALID_ARG(4);
+
+    size_t capacity = deque->_data._capacity;
+    size_t element_size = deque->_data._element_size;
+    size_t start = (deque->_head + pos) & (capacity - 1);
+    size_t first_count = (count < capacity - start) ? count : (capacity - start);
+
+    memcpy(dest, (const char*)deque->_data._data + (start * element_size), first_count * element_size);
+    memcpy((char*)dest + (first_count * element_size), deque->_data._data, (count - first_count) * element_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_empty(GDSDeque* deque)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    deque->_head = 0;
+    deque->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_deque_reserve(GDSDeque* deque, size_t new_capacity)
+{
+    if(deque == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    if(new_capacity <= deque->_data._capacity) return GDS_SUCCESS;
+
+    if(_gds_deque_grow(deque, new_capacity) != GDS_SUCCESS) return GDS_DEQUE_ERR_REALLOC_FAIL;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_deque_get_count(const GDSDeque* deque)
+{
+    return (deque != NULL) ? deque->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_deque_get_capacity(const GDSDeque* deque)
+{
+    return (deque != NULL) ? deque->_data._capacity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_deque_is_empty(const GDSDeque* deque)
+{
+    return (deque != NULL) ? (deque->_count == 0) : true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_deque_get_element_size(const GDSDeque* deque)
+{
+    return (deque != NULL) ? deque->_data._element_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_deque_get_struct_size()
+{
+    return sizeof(GDSDeque);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t _gds_deque_round_capacity(size_t capacity)
+{
+    size_t rounded = 1;
+    while(rounded < capacity) rounded <<= 1;
+
+    return rounded;
+}
+
+static inline void* _gds_deque_slot(const GDSDeque* deque, size_t pos)
+{
+    size_t slot = (deque->_head + pos) & (deque->_data._capacity - 1);
+
+    return (char*)deque->_data._data + (slot * deque->_data._element_size);
+}
+
+static gds_err _gds_deque_grow(GDSDeque* deque, size_t min_capacity)
+{
+    assert(deque != NULL);
+
+    size_t old_capacity = deque->_data._capacity;
+    size_t new_capacity = _gds_deque_round_capacity(min_capacity);
+    if(new_capacity <= old_capacity) return GDS_SUCCESS;
+
+    gds_err realloc_status = gds_array_realloc(&deque->_data, new_capacity);
+    if(realloc_status != GDS_SUCCESS) return GDS_DEQUE_ERR_REALLOC_FAIL;
+
+    size_t element_size = deque->_data._element_size;
+    char* data = deque->_data._data;
+    size_t head_part = old_capacity - deque->_head; // elements from '_head' to the end of the old buffer
+
+    if(deque->_count > head_part)
+    {
+        size_t wrapped_part = deque->_count - head_part; // elements at the start of the buffer
+
+        if(wrapped_part <= head_part)
+            memcpy(data + (old_capacity * element_size), data, wrapped_part * element_size);
+        else
+        {
+            size_t new_head = new_capacity - head_part;
+            memcpy(data + (new_head * element_size), data + (deque->_head * element_size), head_part * element_size);
+            deque->_head = new_head;
+        }
+    }
+
+    return GDS_SUCCESS;
+}
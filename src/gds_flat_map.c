@@ -0,0 +1,448 @@
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_vector.h"
+#include "gds_flat_map.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_FLAT_MAP_DEF_ALLOW__
+#include "def/gds_flat_map_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Searches the sorted keys. If 'upper' is false, returns the index of the first key not less than 'key'. If 'upper'
+ * is true, returns the index of the first key greater than 'key'. Returns the map's count if there is no such key.
+ * The loop has no data-dependent branches - the comparison result only selects the next base through a conditional
+ * move. Assumes non-NULL arguments. */
+static size_t _gds_flat_map_binary_search(const GDSFlatMap* flat_map, const void* key, bool upper);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Same as _gds_flat_map_binary_search(), but searches the Eytzinger layout. Assumes the layout is built. */
+static size_t _gds_flat_map_eytzinger_search(const GDSFlatMap* flat_map, const void* key, bool upper);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Fills the Eytzinger layout by an in-order traversal of the implicit tree rooted at slot 'k'. 'sorted_pos' is the
+ * index of the next sorted key to place. Returns the index of the next sorted key after the subtree is filled. */
+static size_t _gds_flat_map_fill_eytzinger(GDSFlatMap* flat_map, size_t sorted_pos, size_t k);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Frees the Eytzinger layout, if built. Called on every modification of the map. Assumes non-NULL 'flat_map'. */
+static void _gds_flat_map_drop_eytzinger(GDSFlatMap* flat_map);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Dispatches to _gds_flat_map_eytzinger_search() if the Eytzinger layout is built, otherwise to
+ * _gds_flat_map_binary_search(). */
+static size_t _gds_flat_map_search(const GDSFlatMap* flat_map, const void* key, bool upper);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_init(GDSFlatMap* flat_map, size_t key_data_size, size_t value_data_size,
+        int (*key_compare_func)(const void* key1, const void* key2))
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(key_data_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(value_data_size == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(key_compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+
+    flat_map->_key_compare_func = key_compare_func;
+    flat_map->_eytzinger_keys = NULL;
+    flat_map->_eytzinger_index = NULL;
+
+    gds_err init_status = gds_vector_init_default(&flat_map->_keys, key_data_size);
+    if(init_status != GDS_SUCCESS) return GDS_FLATMAP_ERR_MALLOC_FAIL;
+
+    init_status = gds_vector_init_default(&flat_map->_values, value_data_size);
+    if(init_status != GDS_SUCCESS)
+    {
+        gds_vector_destruct(&flat_map->_keys);
+        return GDS_FLATMAP_ERR_MALLOC_FAIL;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSFlatMap* gds_flat_map_create(size_t key_data_size, size_t value_data_size,
+        int (*key_compare_func)(const void* key1, const void* key2))
+{
+    GDSFlatMap* flat_map = (GDSFlatMap*)malloc(sizeof(GDSFlatMap));
+    if(flat_map == NULL) return NULL;
+
+    gds_err init_status = gds_flat_map_init(flat_map, key_data_size, value_data_size, key_compare_func);
+
+    if(init_status == GDS_SUCCESS) return flat_map;
+    else
+    {
+        free(flat_map);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_flat_map_destruct(GDSFlatMap* flat_map)
+{
+    if(flat_map == NULL) return;
+
+    _gds_flat_map_drop_eytzinger(flat_map);
+
+    gds_vector_destruct(&flat_map->_keys);
+    gds_vector_destruct(&flat_map->_values);
+    flat_map->_key_compare_func = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_build(GDSFlatMap* flat_map, const void* keys, const void* values, size_t count)
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if((keys == NULL) && (count > 0)) return GDS_GEN_ERR_INVALID_ARG(2);
+    if((values == NULL) && (count > 0)) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    gds_flat_map_empty(flat_map);
+    if(count == 0) return GDS_SUCCESS;
+
+    size_t key_size = gds_vector_get_element_size(&flat_map->_keys);
+    size_t value_size = gds_vector_get_element_size(&flat_map->_values);
+    size_t record_size = key_size + value_size;
+
+    // entries are sorted as (key, value) records - the key is at the start of each record, so the key compare
+    // function can be used directly.
+    GDSArray records;
+    if(gds_array_init(&records, count, record_size) != GDS_SUCCESS) return GDS_FLATMAP_ERR_MALLOC_FAIL;
+
+    char* record = records._data;
+    size_t i;
+    for(i = 0; i < count; i++)
+    {
+        memcpy(record, (const char*)keys + (i * key_size), key_size);
+        memcpy(record + key_size, (const char*)values + (i * value_size), value_size);
+        record += record_size;
+    }
+    records._count = count;
+
+    gds_array_sort(&records, flat_map->_key_compare_func);
+
+    if((count > gds_vector_get_capacity(&flat_map->_keys)) &&
+            (gds_vector_reserve(&flat_map->_keys, count) != GDS_SUCCESS))
+    {
+        gds_array_destruct(&records);
+        return GDS_FLATMAP_ERR_REALLOC_FAIL;
+    }
+    if((count > gds_vector_get_capacity(&flat_map->_values)) &&
+            (gds_vector_reserve(&flat_map->_values, count) != GDS_SUCCESS))
+    {
+        gds_array_destruct(&records);
+        return GDS_FLATMAP_ERR_REALLOC_FAIL;
+    }
+
+    char* key_data = flat_map->_keys._data._data;
+    char* value_data = flat_map->_values._data._data;
+    size_t unique_count = 0;
+
+    record = records._data;
+    for(i = 0; i < count; i++)
+    {
+        if((unique_count == 0) ||
+                (flat_map->_key_compare_func(key_data + ((unique_count - 1) * key_size), record) != 0))
+        {
+            memcpy(key_data + (unique_count * key_size), record, key_size);
+            unique_count++;
+        }
+
+        memcpy(value_data + ((unique_count - 1) * value_size), record + key_size, value_size);
+        record += record_size;
+    }
+
+    flat_map->_keys._data._count = unique_count;
+    flat_map->_values._data._count = unique_count;
+
+    gds_array_destruct(&records);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_set(GDSFlatMap* flat_map, const void* key, const void* value)
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(key == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(value == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    size_t pos = _gds_flat_map_search(flat_map, key, false);
+
+    if((pos < gds_vector_get_count(&flat_map->_keys)) &&
+            (flat_map->_key_compare_func(gds_vector_at(&flat_map->_keys, pos), key) == 0))
+    {
+        gds_vector_assign(&flat_map->_values, value, pos);
+        return GDS_SUCCESS;
+    }
+
+    _gds_flat_map_drop_eytzinger(flat_map);
+
+    gds_err insert_status = gds_vector_insert_at(&flat_map->_keys, key, pos);
+    if(insert_status != GDS_SUCCESS) return GDS_FLATMAP_ERR_REALLOC_FAIL;
+
+    insert_status = gds_vector_insert_at(&flat_map->_values, value, pos);
+    if(insert_status != GDS_SUCCESS)
+    {
+        gds_vector_remove_at(&flat_map->_keys, pos);
+        return GDS_FLATMAP_ERR_REALLOC_FAIL;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_flat_map_get(const GDSFlatMap* flat_map, const void* key)
+{
+    if(flat_map == NULL) return NULL;
+    if(key == NULL) return NULL;
+
+    size_t pos = _gds_flat_map_search(flat_map, key, false);
+
+    if(pos == gds_vector_get_count(&flat_map->_keys)) return NULL;
+    if(flat_map->_key_compare_func(gds_vector_at(&flat_map->_keys, pos), key) != 0) return NULL;
+
+    return gds_vector_at(&flat_map->_values, pos);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_flat_map_contains(const GDSFlatMap* flat_map, const void* key)
+{
+    return (gds_flat_map_get(flat_map, key) != NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_remove(GDSFlatMap* flat_map, const void* key)
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(key == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t pos = _gds_flat_map_search(flat_map, key, false);
+
+    if(pos == gds_vector_get_count(&flat_map->_keys)) return GDS_FLATMAP_ERR_KEY_NOT_FOUND;
+    if(flat_map->_key_compare_func(gds_vector_at(&flat_map->_keys, pos), key) != 0)
+        return GDS_FLATMAP_ERR_KEY_NOT_FOUND;
+
+    _gds_flat_map_drop_eytzinger(flat_map);
+
+    gds_vector_remove_at(&flat_map->_keys, pos);
+    gds_vector_remove_at(&flat_map->_values, pos);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_empty(GDSFlatMap* flat_map)
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    _gds_flat_map_drop_eytzinger(flat_map);
+
+    gds_vector_empty(&flat_map->_keys);
+    gds_vector_empty(&flat_map->_values);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_flat_map_lower_bound(const GDSFlatMap* flat_map, const void* key)
+{
+    return _gds_flat_map_search(flat_map, key, false);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_flat_map_upper_bound(const GDSFlatMap* flat_map, const void* key)
+{
+    return _gds_flat_map_search(flat_map, key, true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_range(const GDSFlatMap* flat_map, const void* low_key, const void* high_key,
+        size_t* first, size_t* last)
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(low_key == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(high_key == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(first == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(last == NULL) return GDS_GEN_ERR_INVALID_ARG(5);
+
+    *first = _gds_flat_map_search(flat_map, low_key, false);
+    *last = _gds_flat_map_search(flat_map, high_key, false);
+
+    if(*last < *first) *last = *first;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const void* gds_flat_map_key_at(const GDSFlatMap* flat_map, size_t pos)
+{
+    return (flat_map != NULL) ? gds_vector_at(&flat_map->_keys, pos) : NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_flat_map_value_at(const GDSFlatMap* flat_map, size_t pos)
+{
+    return (flat_map != NULL) ? gds_vector_at(&flat_map->_values, pos) : NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_flat_map_build_eytzinger(GDSFlatMap* flat_map)
+{
+    if(flat_map == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(flat_map->_eytzinger_keys != NULL) return GDS_SUCCESS;
+
+    size_t count = gds_vector_get_count(&flat_map->_keys);
+    size_t key_size = gds_vector_get_element_size(&flat_map->_keys);
+
+    // slot 0 is unused - the layout is 1-based, so that the children of slot k are 2k and 2k + 1.
+    flat_map->_eytzinger_keys = malloc((count + 1) * key_size);
+    flat_map->_eytzinger_index = (size_t*)malloc((count + 1) * sizeof(size_t));
+
+    if((flat_map->_eytzinger_keys == NULL) || (flat_map->_eytzinger_index == NULL))
+    {
+        _gds_flat_map_drop_eytzinger(flat_map);
+        return GDS_FLATMAP_ERR_MALLOC_FAIL;
+    }
+
+    _gds_flat_map_fill_eytzinger(flat_map, 0, 1);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_flat_map_get_count(const GDSFlatMap* flat_map)
+{
+    return (flat_map != NULL) ? gds_vector_get_count(&flat_map->_keys) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_flat_map_is_empty(const GDSFlatMap* flat_map)
+{
+    return (flat_map != NULL) ? gds_vector_is_empty(&flat_map->_keys) : true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_flat_map_get_struct_size()
+{
+    return sizeof(GDSFlatMap);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t _gds_flat_map_search(const GDSFlatMap* flat_map, const void* key, bool upper)
+{
+    if(flat_map->_eytzinger_keys != NULL) return _gds_flat_map_eytzinger_search(flat_map, key, upper);
+    else return _gds_flat_map_binary_search(flat_map, key, upper);
+}
+
+static size_t _gds_flat_map_binary_search(const GDSFlatMap* flat_map, const void* key, bool upper)
+{
+    assert(flat_map != NULL);
+    assert(key != NULL);
+
+    size_t count = flat_map->_keys._data._count;
+    size_t key_size = flat_map->_keys._data._element_size;
+    const char* keys = flat_map->_keys._data._data;
+    int (*compare_func)(const void*, const void*) = flat_map->_key_compare_func;
+
+    if(count == 0) return 0;
+
+    const char* base = keys;
+    size_t half;
+    int cmp;
+    while(count > 1)
+    {
+        half = count / 2;
+        cmp = compare_func(base + (half * key_size), key);
+        base = ((upper ? (cmp <= 0) : (cmp < 0))) ? (base + (half * key_size)) : base;
+        count -= half;
+    }
+
+    cmp = compare_func(base, key);
+
+    return ((base - keys) / key_size) + (upper ? (cmp <= 0) : (cmp < 0));
+}
+
+static size_t _gds_flat_map_eytzinger_search(const GDSFlatMap* flat_map, const void* key, bool upper)
+{
+    assert(flat_map != NULL);
+    assert(key != NULL);
+
+    size_t count = flat_map->_keys._data._count;
+    size_t key_size = flat_map->_keys._data._element_size;
+    const char* keys = flat_map->_eytzinger_keys;
+    int (*compare_func)(const void*, const void*) = flat_map->_key_compare_func;
+
+    size_t k = 1;
+    int cmp;
+    while(k <= count)
+    {
+        // the 16 descendants of 'k', four levels down, are stored contiguously - fetch them ahead of time.
+        if((16 * k) <= count) __builtin_prefetch(keys + (16 * k * key_size));
+
+        cmp = compare_func(keys + (k * key_size), key);
+        k = (2 * k) + (upper ? (cmp <= 0) : (cmp < 0));
+    }
+
+    // 'k' went right once more after the last left turn, at the answer - undo those right turns and the left one.
+    k >>= __builtin_ffsll(~k);
+
+    return (k == 0) ? count : flat_map->_eytzinger_index[k];
+}
+
+static size_t _gds_flat_map_fill_eytzinger(GDSFlatMap* flat_map, size_t sorted_pos, size_t k)
+{
+    size_t count = flat_map->_keys._data._count;
+    size_t key_size = flat_map->_keys._data._element_size;
+
+    if(k <= count)
+    {
+        sorted_pos = _gds_flat_map_fill_eytzinger(flat_map, sorted_pos, 2 * k);
+
+        memcpy((char*)flat_map->_eytzinger_keys + (k * key_size),
+                (char*)flat_map->_keys._data._data + (sorted_pos * key_size), key_size);
+        flat_map->_eytzinger_index[k] = sorted_pos;
+        sorted_pos++;
+
+        sorted_pos = _gds_flat_map_fill_eytzinger(flat_map, sorted_pos, (2 * k) + 1);
+    }
+
+    return sorted_pos;
+}
+
+static void _gds_flat_map_drop_eytzinger(GDSFlatMap* flat_map)
+{
+    assert(flat_map != NULL);
+
+    free(flat_map->_eytzinger_keys);
+    free(flat_map->_eytzinger_index);
+
+    flat_map->_eytzinger_keys = NULL;
+    flat_map->_eytzinger_index = NULL;
+}
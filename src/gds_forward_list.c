@@ -5,6 +5,7 @@
 
 #include "gds.h"
 #include "gds_misc.h"
+#include "gds_slab.h"
 #include "gds_forward_list.h"
 
 #ifdef GDS_ENABLE_OPAQUE_STRUCTS
@@ -16,13 +17,16 @@ typedef struct _GDSForwardListNodeBase _GDSForwardListNodeBase;
 
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
-/* Dynamically allocates sizeof(_GDSForwardListNodeBase) + list->_data_size bytes for the list node. Returns NULL if
- * it fails. The function assumes that 'list' is non-NULL and 'data' is non-NULL. */
+/* Allocates a node from the list's slab and copies 'data' into it. Returns NULL if it fails. The function assumes
+ * that 'list' is non-NULL and 'data' is non-NULL. */
 static _GDSForwardListNodeBase* _gds_forward_list_alloc_node(const GDSForwardList* list, const void* data);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-/* Returns address of node with index 'pos'. Function assumes non-NULL 'list' argument and that 'pos' is in bounds
+/* Returns address of node with index 'pos'. The search starts from the node found by the previous call, if it isn't
+ * past 'pos', and from the head otherwise - so accessing positions in increasing order is O(1) per access. The found
+ * node is cached for the next call - this writes to 'list' despite the const, so concurrent calls on one list aren't
+ * safe(documented in gds_forward_list_at()). Function assumes non-NULL 'list' argument and that 'pos' is in bounds
  * ('pos' < list->_count). */
 static _GDSForwardListNodeBase* _gds_forward_list_at_node(const GDSForwardList* list, size_t pos);
 
@@ -30,19 +34,54 @@ static _GDSForwardListNodeBase* _gds_forward_list_at_node(const GDSForwardList*
 
 /* Function to call when removing nodes from the list. This function assumes non-NULL argument 'list' and 'node'.
  * First, the function calls list->_on_element_removal_func if non-NULL.
- * Then, it frees the node pointed to by 'node'. */
+ * Then, it returns the node pointed to by 'node' to the list's slab. */
 static void _gds_forward_list_on_node_removal(const GDSForwardList* list, _GDSForwardListNodeBase* node);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-/* Function assumes non-NULL 'list' argument. Returns size of one node in a list. */
-static size_t _gds_forward_list_get_node_size(const GDSForwardList* list);
+/* Forgets the node cached by _gds_forward_list_at_node(). Called by every function that changes the list in a way
+ * that may move the cached node to another position. Function assumes non-NULL 'list' argument. */
+static inline void _gds_forward_list_invalidate_cache(GDSForwardList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function assumes non-NULL 'list' argument. Returns the slab the list's nodes are allocated from. */
+static GDSSlab* _gds_forward_list_get_slab(GDSForwardList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls list->_on_element_removal_func for every element, if non-NULL, and releases all nodes. If the list has its
+ * own slab, its chunks are freed at once instead of freeing nodes one by one. The function assumes non-NULL 'list'
+ * argument. */
+static void _gds_forward_list_release_all(GDSForwardList* list);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 /* Function assumes non-NULL 'node' argument. It returns the address of node's data. */
 static void* _gds_forward_list_get_data_for_node(_GDSForwardListNodeBase* node);
 
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Merges the sorted, NULL-terminated chains of nodes 'first' and 'second' into one sorted chain, by relinking. On equal
+ * elements, the node of 'first' goes first. Returns the head of the merged chain and stores its last node in
+ * 'out_tail', if non-NULL. Assumes non-NULL 'compare_func'. */
+static _GDSForwardListNodeBase* _gds_forward_list_merge_chains(_GDSForwardListNodeBase* first,
+        _GDSForwardListNodeBase* second, int (*compare_func)(const void*, const void*),
+        _GDSForwardListNodeBase** out_tail);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Detaches the last 'count' nodes of 'src' - the nodes after 'prev', or all nodes if 'prev' is NULL - and returns the
+ * head of a NULL-terminated chain of them that may be linked into 'dest'. If both lists allocate from the same slab,
+ * this is the chain of 'src' itself. It is also the chain of 'src' if all nodes are taken from a list with its own
+ * slab - the chunks of that slab are handed over to the slab of 'dest'. Otherwise, each element is copied into a
+ * node allocated from the slab of 'dest', and the nodes of 'src' are freed without calling
+ * _on_element_removal_func. The last node of the chain is stored in
+ * 'out_tail'. Returns NULL if allocating fails - in that case, 'src' is unchanged. Assumes non-NULL 'dest', 'src' and
+ * 'out_tail', lists with the same data size and 'count' > 0. */
+static _GDSForwardListNodeBase* _gds_forward_list_take_nodes(GDSForwardList* dest, GDSForwardList* src,
+        _GDSForwardListNodeBase* prev, size_t count, _GDSForwardListNodeBase** out_tail);
+
 // ------------------------------------------------------------------------------------------------------------------------------------------
 
 gds_err gds_forward_list_init(GDSForwardList* list, size_t data_size, void (*_on_element_removal_func)(void*))
@@ -53,14 +92,38 @@ gds_err gds_forward_list_init(GDSForwardList* list, size_t data_size, void (*_on
     list->_count = 0;
     list->_head = NULL;
     list->_tail = NULL;
+    list->_cache_node = NULL;
+    list->_cache_pos = 0;
     list->_data_size = data_size;
     list->_on_element_removal_func = _on_element_removal_func;
+    list->_shared_slab = NULL;
+
+    gds_err slab_init_status = gds_slab_init(&list->_own_slab, gds_forward_list_get_node_size(data_size), 0);
+    if(slab_init_status != GDS_SUCCESS) return GDS_GEN_ERR_INTERNAL_ERR;
     
     return GDS_SUCCESS;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+gds_err gds_forward_list_init_shared(GDSForwardList* list, size_t data_size, void (*_on_element_removal_func)(void*),
+        GDSSlab* slab)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(slab == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(gds_slab_get_object_size(slab) < gds_forward_list_get_node_size(data_size)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    gds_err init_status = gds_forward_list_init(list, data_size, _on_element_removal_func);
+    if(init_status != GDS_SUCCESS) return init_status;
+
+    list->_shared_slab = slab;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 GDSForwardList* gds_forward_list_create(size_t data_size, void (*_on_element_removal_func)(void*))
 {
     if(data_size == 0) return NULL;
@@ -81,17 +144,40 @@ GDSForwardList* gds_forward_list_create(size_t data_size, void (*_on_element_rem
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+GDSForwardList* gds_forward_list_create_shared(size_t data_size, void (*_on_element_removal_func)(void*),
+        GDSSlab* slab)
+{
+    GDSForwardList* new_list = (GDSForwardList*)malloc(sizeof(GDSForwardList));
+    if(new_list == NULL) return NULL;
+
+    gds_err init_status = gds_forward_list_init_shared(new_list, data_size, _on_element_removal_func, slab);
+
+    if(init_status != GDS_SUCCESS)
+    {
+        free(new_list);
+        return NULL;
+    }
+
+    else return new_list;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void gds_forward_list_destruct(GDSForwardList* list)
 {
     if(list == NULL) return;
 
-    gds_forward_list_empty(list);
+    _gds_forward_list_release_all(list);
+    gds_slab_destruct(&list->_own_slab);
 
     list->_head = NULL;
     list->_tail = NULL;
+    list->_cache_node = NULL;
+    list->_cache_pos = 0;
     list->_data_size = 0;
     list->_count = 0;
     list->_on_element_removal_func = NULL;
+    list->_shared_slab = NULL;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -188,6 +274,9 @@ gds_err gds_forward_list_push_front(GDSForwardList* list, const void* data)
         list->_head = new;
     }
 
+    // the cached node moves one position further.
+    if(list->_cache_node != NULL) list->_cache_pos++;
+
     list->_count++;
 
     return GDS_SUCCESS;
@@ -227,6 +316,9 @@ gds_err gds_forward_list_pop_front(GDSForwardList* list)
 
     _GDSForwardListNodeBase* next_head = list->_head->next;
 
+    if(list->_cache_node == list->_head) _gds_forward_list_invalidate_cache(list);
+    else if(list->_cache_node != NULL) list->_cache_pos--;
+
     _gds_forward_list_on_node_removal(list, list->_head);
 
     list->_head = next_head;
@@ -265,11 +357,272 @@ gds_err gds_forward_list_remove_at(GDSForwardList* list, size_t pos)
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+gds_err gds_forward_list_insert_after(GDSForwardList* list, GDSForwardListIterator* iterator, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    _GDSForwardListNodeBase* new = _gds_forward_list_alloc_node(list, data);
+    if(new == NULL) return GDS_FWDLIST_ERR_MALLOC_FAIL;
+
+    _gds_forward_list_invalidate_cache(list);
+
+    _GDSForwardListNodeBase* node = iterator->_curr_node;
+
+    new->next = node->next;
+    node->next = new;
+
+    if(node == list->_tail) list->_tail = new;
+
+    list->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_erase_after(GDSForwardList* list, GDSForwardListIterator* iterator)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    _GDSForwardListNodeBase* node = iterator->_curr_node;
+    if(node == list->_tail) return GDS_FWDLIST_ITER_ERR_OUT_OF_BOUNDS;
+
+    _GDSForwardListNodeBase* removed = node->next;
+
+    _gds_forward_list_invalidate_cache(list);
+
+    node->next = removed->next;
+    if(removed == list->_tail) list->_tail = node;
+
+    _gds_forward_list_on_node_removal(list, removed);
+
+    list->_count--;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_remove_if(GDSForwardList* list, bool (*pred)(const void* data, void* ctx), void* ctx)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pred == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _gds_forward_list_invalidate_cache(list);
+
+    _GDSForwardListNodeBase* prev = NULL;
+    _GDSForwardListNodeBase* node = list->_head;
+    size_t remaining = list->_count;
+
+    while(remaining > 0)
+    {
+        _GDSForwardListNodeBase* next = node->next;
+
+        if(pred(_gds_forward_list_get_data_for_node(node), ctx))
+        {
+            if(prev != NULL) prev->next = next;
+            else list->_head = next;
+
+            if(node == list->_tail) list->_tail = prev;
+
+            _gds_forward_list_on_node_removal(list, node);
+            list->_count--;
+        }
+        else prev = node;
+
+        node = next;
+        remaining--;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_sort(GDSForwardList* list, int (*compare_func)(const void*, const void*))
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(list->_count < 2) return GDS_SUCCESS;
+
+    _gds_forward_list_invalidate_cache(list);
+
+    // runs[i] is either empty or a sorted chain of 2^i nodes. Each node is merged in as a run of length 1, carrying
+    // into higher levels like a binary counter. A run in a higher level holds elements that came earlier in the list,
+    // so it is always passed first to keep the sort stable.
+    _GDSForwardListNodeBase* runs[sizeof(size_t) * 8] = { NULL };
+    size_t max_level = 0;
+
+    _GDSForwardListNodeBase* node = list->_head;
+    _GDSForwardListNodeBase* carry;
+    size_t remaining = list->_count;
+    size_t i;
+
+    while(remaining > 0)
+    {
+        carry = node;
+        node = node->next;
+        carry->next = NULL;
+        remaining--;
+
+        for(i = 0; runs[i] != NULL; i++)
+        {
+            carry = _gds_forward_list_merge_chains(runs[i], carry, compare_func, NULL);
+            runs[i] = NULL;
+        }
+
+        runs[i] = carry;
+        if(i > max_level) max_level = i;
+    }
+
+    // runs[max_level] is never empty, so the last merge is the one that finds the tail.
+    carry = NULL;
+    for(i = 0; i < max_level; i++)
+    {
+        if(runs[i] != NULL) carry = _gds_forward_list_merge_chains(runs[i], carry, compare_func, NULL);
+    }
+
+    list->_head = _gds_forward_list_merge_chains(runs[max_level], carry, compare_func, &list->_tail);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_merge(GDSForwardList* dest, GDSForwardList* src,
+        int (*compare_func)(const void*, const void*))
+{
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(dest->_data_size != src->_data_size) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    if((dest == src) || (src->_count == 0)) return GDS_SUCCESS;
+
+    size_t src_count = src->_count;
+    _GDSForwardListNodeBase* src_tail;
+    _GDSForwardListNodeBase* src_head = _gds_forward_list_take_nodes(dest, src, NULL, src_count, &src_tail);
+    if(src_head == NULL) return GDS_FWDLIST_ERR_MALLOC_FAIL;
+
+    _gds_forward_list_invalidate_cache(dest);
+
+    if(dest->_count == 0)
+    {
+        dest->_head = src_head;
+        dest->_tail = src_tail;
+    }
+    else
+    {
+        dest->_tail->next = NULL;
+        dest->_head = _gds_forward_list_merge_chains(dest->_head, src_head, compare_func, &dest->_tail);
+    }
+
+    dest->_count += src_count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_splice_back(GDSForwardList* dest, GDSForwardList* src)
+{
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if((dest == src) || (dest->_data_size != src->_data_size)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    if(src->_count == 0) return GDS_SUCCESS;
+
+    size_t src_count = src->_count;
+    _GDSForwardListNodeBase* src_tail;
+    _GDSForwardListNodeBase* src_head = _gds_forward_list_take_nodes(dest, src, NULL, src_count, &src_tail);
+    if(src_head == NULL) return GDS_FWDLIST_ERR_MALLOC_FAIL;
+
+    if(dest->_count == 0) dest->_head = src_head;
+    else dest->_tail->next = src_head;
+
+    dest->_tail = src_tail;
+    dest->_count += src_count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_splice_after(GDSForwardList* dest, GDSForwardListIterator* iterator, GDSForwardList* src)
+{
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if((dest == src) || (dest->_data_size != src->_data_size)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    if(src->_count == 0) return GDS_SUCCESS;
+
+    size_t src_count = src->_count;
+    _GDSForwardListNodeBase* src_tail;
+    _GDSForwardListNodeBase* src_head = _gds_forward_list_take_nodes(dest, src, NULL, src_count, &src_tail);
+    if(src_head == NULL) return GDS_FWDLIST_ERR_MALLOC_FAIL;
+
+    _gds_forward_list_invalidate_cache(dest);
+
+    _GDSForwardListNodeBase* node = iterator->_curr_node;
+
+    src_tail->next = node->next;
+    node->next = src_head;
+
+    if(node == dest->_tail) dest->_tail = src_tail;
+
+    dest->_count += src_count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_forward_list_split_at(GDSForwardList* list, GDSForwardListIterator* iterator, GDSForwardList* dest)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if((list == dest) || (list->_data_size != dest->_data_size)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    // the iterator's position goes stale when elements are inserted or removed before it, so the nodes that follow
+    // it are counted by walking the chain.
+    size_t moved_count = 0;
+    _GDSForwardListNodeBase* it;
+    for(it = iterator->_curr_node->next; it != NULL; it = it->next)
+        moved_count++;
+
+    if(moved_count == 0) return GDS_SUCCESS;
+
+    _GDSForwardListNodeBase* moved_tail;
+    _GDSForwardListNodeBase* moved_head = _gds_forward_list_take_nodes(dest, list, iterator->_curr_node, moved_count,
+            &moved_tail);
+    if(moved_head == NULL) return GDS_FWDLIST_ERR_MALLOC_FAIL;
+
+    if(dest->_count == 0) dest->_head = moved_head;
+    else dest->_tail->next = moved_head;
+
+    dest->_tail = moved_tail;
+    dest->_count += moved_count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 gds_err gds_forward_list_empty(GDSForwardList* list)
 {
     if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
 
-    while(list->_count != 0) gds_forward_list_pop_front(list);
+    _gds_forward_list_release_all(list);
 
     return GDS_SUCCESS;
 }
@@ -299,6 +652,13 @@ size_t gds_forward_list_get_data_size(const GDSForwardList* list)
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+size_t gds_forward_list_get_node_size(size_t data_size)
+{
+    return (sizeof(_GDSForwardListNodeBase) + data_size);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 size_t gds_forward_list_get_struct_size()
 {
     return sizeof(GDSForwardList);
@@ -391,9 +751,12 @@ static _GDSForwardListNodeBase* _gds_forward_list_alloc_node(const GDSForwardLis
     assert(list != NULL);
     assert(data != NULL);
 
-    _GDSForwardListNodeBase* new = (_GDSForwardListNodeBase*)malloc(_gds_forward_list_get_node_size(list));
+    _GDSForwardListNodeBase* new = (_GDSForwardListNodeBase*)gds_slab_alloc(
+            _gds_forward_list_get_slab((GDSForwardList*)list));
     if(new == NULL) return NULL;
 
+    new->next = NULL;
+
     void* node_data = _gds_forward_list_get_data_for_node(new);
 
     memcpy(node_data, data, list->_data_size);
@@ -407,14 +770,30 @@ static _GDSForwardListNodeBase* _gds_forward_list_at_node(const GDSForwardList*
     assert(pos < list->_count);
 
     if(pos == (list->_count - 1)) return list->_tail;
+
+    // the cache doesn't change the list's contents, so it is updated through lists passed as const too.
+    GDSForwardList* cached_list = (GDSForwardList*)list;
+
+    _GDSForwardListNodeBase* it;
+    size_t i;
+
+    if((list->_cache_node != NULL) && (list->_cache_pos <= pos))
+    {
+        it = list->_cache_node;
+        i = list->_cache_pos;
+    }
     else
     {
-        _GDSForwardListNodeBase* it = list->_head;
-        size_t i;
-        for(i = 0; i < pos; i++) it = it->next;
-        return it;
+        it = list->_head;
+        i = 0;
     }
 
+    for(; i < pos; i++) it = it->next;
+
+    cached_list->_cache_node = it;
+    cached_list->_cache_pos = pos;
+
+    return it;
 }
 
 static void _gds_forward_list_on_node_removal(const GDSForwardList* list, _GDSForwardListNodeBase* node)
@@ -425,14 +804,54 @@ static void _gds_forward_list_on_node_removal(const GDSForwardList* list, _GDSFo
     void* node_data = _gds_forward_list_get_data_for_node(node);
     if(list->_on_element_removal_func != NULL) list->_on_element_removal_func(node_data);
 
-    free(node);
+    gds_slab_free(_gds_forward_list_get_slab((GDSForwardList*)list), node);
+}
+
+static inline void _gds_forward_list_invalidate_cache(GDSForwardList* list)
+{
+    assert(list != NULL);
+
+    list->_cache_node = NULL;
+    list->_cache_pos = 0;
 }
 
-static size_t _gds_forward_list_get_node_size(const GDSForwardList* list)
+static GDSSlab* _gds_forward_list_get_slab(GDSForwardList* list)
 {
     assert(list != NULL);
 
-    return (sizeof(_GDSForwardListNodeBase) + list->_data_size);
+    return (list->_shared_slab != NULL) ? list->_shared_slab : &list->_own_slab;
+}
+
+static void _gds_forward_list_release_all(GDSForwardList* list)
+{
+    assert(list != NULL);
+
+    _gds_forward_list_invalidate_cache(list);
+
+    if(list->_shared_slab != NULL)
+    {
+        while(list->_count != 0) gds_forward_list_pop_front(list);
+        return;
+    }
+
+    if(list->_on_element_removal_func != NULL)
+    {
+        _GDSForwardListNodeBase* it = list->_head;
+        size_t i;
+        for(i = 0; i < list->_count; i++)
+        {
+            list->_on_element_removal_func(_gds_forward_list_get_data_for_node(it));
+            it = it->next;
+        }
+    }
+
+    // the slab starts over from a small chunk, so an emptied list doesn't hold on to memory.
+    gds_slab_destruct(&list->_own_slab);
+    gds_slab_init(&list->_own_slab, gds_forward_list_get_node_size(list->_data_size), 0);
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_count = 0;
 }
 
 static void* _gds_forward_list_get_data_for_node(_GDSForwardListNodeBase* node)
@@ -441,3 +860,101 @@ static void* _gds_forward_list_get_data_for_node(_GDSForwardListNodeBase* node)
 
     return (((void*)node) + sizeof(_GDSForwardListNodeBase*));
 }
+
+static _GDSForwardListNodeBase* _gds_forward_list_merge_chains(_GDSForwardListNodeBase* first,
+        _GDSForwardListNodeBase* second, int (*compare_func)(const void*, const void*),
+        _GDSForwardListNodeBase** out_tail)
+{
+    assert(compare_func != NULL);
+
+    _GDSForwardListNodeBase head;
+    _GDSForwardListNodeBase* last = &head;
+
+    while((first != NULL) && (second != NULL))
+    {
+        if(compare_func(_gds_forward_list_get_data_for_node(second), _gds_forward_list_get_data_for_node(first)) < 0)
+        {
+            last->next = second;
+            second = second->next;
+        }
+        else
+        {
+            last->next = first;
+            first = first->next;
+        }
+
+        last = last->next;
+    }
+
+    last->next = (first != NULL) ? first : second;
+
+    if(out_tail != NULL)
+    {
+        while(last->next != NULL) last = last->next;
+        *out_tail = last;
+    }
+
+    return head.next;
+}
+
+static _GDSForwardListNodeBase* _gds_forward_list_take_nodes(GDSForwardList* dest, GDSForwardList* src,
+        _GDSForwardListNodeBase* prev, size_t count, _GDSForwardListNodeBase** out_tail)
+{
+    assert(dest != NULL);
+    assert(src != NULL);
+    assert(out_tail != NULL);
+    assert(dest->_data_size == src->_data_size);
+    assert((count > 0) && (count <= src->_count));
+
+    _GDSForwardListNodeBase* head = (prev != NULL) ? prev->next : src->_head;
+    _GDSForwardListNodeBase* tail = src->_tail;
+
+    GDSSlab* dest_slab = _gds_forward_list_get_slab(dest);
+    GDSSlab* src_slab = _gds_forward_list_get_slab(src);
+
+    bool whole_own_slab = (count == src->_count) && (src->_shared_slab == NULL) &&
+        (gds_slab_get_object_size(dest_slab) == gds_slab_get_object_size(src_slab));
+
+    // all nodes of 'src' live in chunks of its own slab, so handing the chunks over moves them without copying.
+    if(whole_own_slab)
+    {
+        if(gds_slab_absorb(dest_slab, src_slab) != GDS_SUCCESS) return NULL;
+    }
+    else if(dest_slab != src_slab)
+    {
+        // reserving first means no allocation below can fail, so 'src' is never left half copied.
+        if(gds_slab_reserve(dest_slab, count) != GDS_SUCCESS) return NULL;
+
+        _GDSForwardListNodeBase copy_head;
+        _GDSForwardListNodeBase* last = &copy_head;
+        _GDSForwardListNodeBase* it = head;
+        size_t i;
+        for(i = 0; i < count; i++)
+        {
+            _GDSForwardListNodeBase* next = it->next;
+
+            last->next = _gds_forward_list_alloc_node(dest, _gds_forward_list_get_data_for_node(it));
+            last = last->next;
+
+            gds_slab_free(src_slab, it);
+            it = next;
+        }
+
+        head = copy_head.next;
+        tail = last;
+    }
+
+    tail->next = NULL;
+
+    _gds_forward_list_invalidate_cache(src);
+
+    if(prev != NULL) prev->next = NULL;
+    else src->_head = NULL;
+
+    src->_tail = prev;
+    src->_count -= count;
+
+    *out_tail = tail;
+
+    return head;
+}
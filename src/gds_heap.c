@@ -0,0 +1,617 @@
+#include "gds.h"
+#include "gds_vector.h"
+#include "gds_heap.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_HEAP_DEF_ALLOW__
+#include "def/gds_heap_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+#define _GDS_HEAP_NO_POSITION SIZE_MAX
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Performs the initialization shared by gds_heap_init() and gds_heap_init_indexed(). Return values are the same as
+ * for gds_heap_init(). */
+static gds_err _gds_heap_init(GDSHeap* heap, size_t element_size, size_t arity,
+        int (*compare_func)(const void*, const void*), bool indexed);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Grows the heap's storage, so it can hold 'new_count' elements - by the resize factor, or to 'new_count' if that is
+ * more. For indexed heaps, the handle tables are grown as well, so assigning handles to up to 'new_count' elements
+ * can't fail. Returns GDS_SUCCESS or GDS_HEAP_ERR_REALLOC_FAIL. Assumes non-NULL 'heap'. */
+static gds_err _gds_heap_reserve(GDSHeap* heap, size_t new_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element at position 'pos'. Assumes non-NULL 'heap'. */
+static inline void* _gds_heap_at(const GDSHeap* heap, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns a handle that isn't used by any element - a reused one, if available. Assumes an indexed heap with enough
+ * room in its handle tables. */
+static size_t _gds_heap_acquire_handle(GDSHeap* heap);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Marks the handle of the element at position 'pos' as unused. Assumes an indexed heap. */
+static void _gds_heap_release_handle(GDSHeap* heap, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies the element at position 'src_pos'(and its handle, for indexed heaps) to position 'dest_pos'. */
+static inline void _gds_heap_move(GDSHeap* heap, size_t dest_pos, size_t src_pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves the element at position 'pos' up, until its parent comes before it. */
+static void _gds_heap_sift_up(GDSHeap* heap, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves the element at position 'pos' down, until none of its children come before it. */
+static void _gds_heap_sift_down(GDSHeap* heap, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Moves the element at position 'pos' up or down, whichever restores the heap order. */
+static void _gds_heap_restore(GDSHeap* heap, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Arranges all elements into a heap, by sifting down every node that has children, bottom-up. Runs in O(n) time. */
+static void _gds_heap_build(GDSHeap* heap);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_init(GDSHeap* heap, size_t element_size, size_t arity, int (*compare_func)(const void*, const void*))
+{
+    return _gds_heap_init(heap, element_size, arity, compare_func, false);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_init_default(GDSHeap* heap, size_t element_size, int (*compare_func)(const void*, const void*))
+{
+    return gds_heap_init(heap, element_size, GDS_HEAP_DEFAULT_ARITY, compare_func);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_init_indexed(GDSHeap* heap, size_t element_size, size_t arity,
+        int (*compare_func)(const void*, const void*))
+{
+    return _gds_heap_init(heap, element_size, arity, compare_func, true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSHeap* gds_heap_create(size_t element_size, size_t arity, int (*compare_func)(const void*, const void*))
+{
+    GDSHeap* heap = (GDSHeap*)malloc(sizeof(GDSHeap));
+    if(heap == NULL) return NULL;
+
+    gds_err init_status = gds_heap_init(heap, element_size, arity, compare_func);
+
+    if(init_status == GDS_SUCCESS) return heap;
+    else
+    {
+        free(heap);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSHeap* gds_heap_create_indexed(size_t element_size, size_t arity, int (*compare_func)(const void*, const void*))
+{
+    GDSHeap* heap = (GDSHeap*)malloc(sizeof(GDSHeap));
+    if(heap == NULL) return NULL;
+
+    gds_err init_status = gds_heap_init_indexed(heap, element_size, arity, compare_func);
+
+    if(init_status == GDS_SUCCESS) return heap;
+    else
+    {
+        free(heap);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_heap_destruct(GDSHeap* heap)
+{
+    if(heap == NULL) return;
+
+    gds_vector_destruct(&heap->_data);
+    free(heap->_hole_buff);
+
+    if(heap->_indexed)
+    {
+        gds_vector_destruct(&heap->_handles);
+        gds_vector_destruct(&heap->_positions);
+        gds_vector_destruct(&heap->_free_handles);
+    }
+
+    heap->_compare_func = NULL;
+    heap->_arity = 0;
+    heap->_hole_buff = NULL;
+    heap->_indexed = false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_push(GDSHeap* heap, const void* data, size_t* out_handle)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t count = heap->_data._data._count;
+
+    gds_err reserve_status = _gds_heap_reserve(heap, count + 1);
+    if(reserve_status != GDS_SUCCESS) return reserve_status;
+
+    memcpy(_gds_heap_at(heap, count), data, heap->_data._data._element_size);
+
+    if(heap->_indexed)
+    {
+        size_t handle = _gds_heap_acquire_handle(heap);
+        ((size_t*)heap->_handles._data._data)[count] = handle;
+        ((size_t*)heap->_positions._data._data)[handle] = count;
+
+        if(out_handle != NULL) *out_handle = handle;
+    }
+
+    heap->_data._data._count++;
+    _gds_heap_sift_up(heap, count);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_push_n(GDSHeap* heap, const void* data, size_t count, size_t* out_handles)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(count == 0) return GDS_SUCCESS;
+
+    size_t old_count = heap->_data._data._count;
+
+    gds_err reserve_status = _gds_heap_reserve(heap, old_count + count);
+    if(reserve_status != GDS_SUCCESS) return reserve_status;
+
+    memcpy(_gds_heap_at(heap, old_count), data, count * heap->_data._data._element_size);
+
+    if(heap->_indexed)
+    {
+        size_t* handles = (size_t*)heap->_handles._data._data;
+        size_t* positions = (size_t*)heap->_positions._data._data;
+
+        size_t i;
+        for(i = 0; i < count; i++)
+        {
+            size_t handle = _gds_heap_acquire_handle(heap);
+            handles[old_count + i] = handle;
+            positions[handle] = old_count + i;
+
+            if(out_handles != NULL) out_handles[i] = handle;
+        }
+    }
+
+    heap->_data._data._count = old_count + count;
+
+    // sifting up each new element costs O(count * log n) - rebuilding costs O(n), which is less once the batch is
+    // about as large as the heap.
+    if(count >= old_count) _gds_heap_build(heap);
+    else
+    {
+        size_t i;
+        for(i = old_count; i < old_count + count; i++) _gds_heap_sift_up(heap, i);
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_heapify(GDSHeap* heap, const GDSVector* vector)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(vector->_data._element_size != heap->_data._data._element_size) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    gds_heap_empty(heap);
+
+    return gds_heap_push_n(heap, vector->_data._data, vector->_data._count, NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_heap_top(const GDSHeap* heap)
+{
+    if(heap == NULL) return NULL;
+    if(heap->_data._data._count == 0) return NULL;
+
+    return heap->_data._data._data;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_pop(GDSHeap* heap, void* out_data)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(heap->_data._data._count == 0) return GDS_HEAP_ERR_HEAP_EMPTY;
+
+    if(out_data != NULL) memcpy(out_data, _gds_heap_at(heap, 0), heap->_data._data._element_size);
+
+    if(heap->_indexed) _gds_heap_release_handle(heap, 0);
+
+    size_t last = --heap->_data._data._count;
+    if(last > 0)
+    {
+        _gds_heap_move(heap, 0, last);
+        _gds_heap_sift_down(heap, 0);
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_push_pop(GDSHeap* heap, const void* data, void* out_data)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(out_data == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(heap->_indexed) return GDS_HEAP_ERR_INDEXED;
+
+    size_t element_size = heap->_data._data._element_size;
+    void* top = _gds_heap_at(heap, 0);
+
+    if((heap->_data._data._count == 0) || (heap->_compare_func(data, top) <= 0))
+    {
+        memmove(out_data, data, element_size);
+        return GDS_SUCCESS;
+    }
+
+    // 'data' is saved first, in case it overlaps 'out_data'.
+    memcpy(heap->_hole_buff, data, element_size);
+    memcpy(out_data, top, element_size);
+    memcpy(top, heap->_hole_buff, element_size);
+
+    _gds_heap_sift_down(heap, 0);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_heap_at_handle(const GDSHeap* heap, size_t handle)
+{
+    if(!gds_heap_contains(heap, handle)) return NULL;
+
+    return _gds_heap_at(heap, ((size_t*)heap->_positions._data._data)[handle]);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_heap_contains(const GDSHeap* heap, size_t handle)
+{
+    if(heap == NULL) return false;
+    if(!heap->_indexed) return false;
+    if(handle >= heap->_positions._data._count) return false;
+
+    return (((size_t*)heap->_positions._data._data)[handle] != _GDS_HEAP_NO_POSITION);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_decrease_key(GDSHeap* heap, size_t handle, const void* data)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(!heap->_indexed) return GDS_HEAP_ERR_NOT_INDEXED;
+    if(!gds_heap_contains(heap, handle)) return GDS_HEAP_ERR_INVALID_HANDLE;
+
+    size_t pos = ((size_t*)heap->_positions._data._data)[handle];
+    memmove(_gds_heap_at(heap, pos), data, heap->_data._data._element_size);
+
+    _gds_heap_restore(heap, pos);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_remove(GDSHeap* heap, size_t handle, void* out_data)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(!heap->_indexed) return GDS_HEAP_ERR_NOT_INDEXED;
+    if(!gds_heap_contains(heap, handle)) return GDS_HEAP_ERR_INVALID_HANDLE;
+
+    size_t pos = ((size_t*)heap->_positions._data._data)[handle];
+
+    if(out_data != NULL) memcpy(out_data, _gds_heap_at(heap, pos), heap->_data._data._element_size);
+
+    _gds_heap_release_handle(heap, pos);
+
+    size_t last = --heap->_data._data._count;
+    if(pos != last)
+    {
+        _gds_heap_move(heap, pos, last);
+        _gds_heap_restore(heap, pos);
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_heap_empty(GDSHeap* heap)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    heap->_data._data._count = 0;
+
+    if(heap->_indexed)
+    {
+        heap->_positions._data._count = 0;
+        heap->_free_handles._data._count = 0;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_heap_get_count(const GDSHeap* heap)
+{
+    return (heap != NULL) ? heap->_data._data._count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_heap_is_empty(const GDSHeap* heap)
+{
+    return (heap != NULL) ? (heap->_data._data._count == 0) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_heap_get_element_size(const GDSHeap* heap)
+{
+    return (heap != NULL) ? heap->_data._data._element_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_heap_get_arity(const GDSHeap* heap)
+{
+    return (heap != NULL) ? heap->_arity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_heap_is_indexed(const GDSHeap* heap)
+{
+    return (heap != NULL) ? heap->_indexed : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_heap_get_struct_size()
+{
+    return sizeof(GDSHeap);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static gds_err _gds_heap_init(GDSHeap* heap, size_t element_size, size_t arity,
+        int (*compare_func)(const void*, const void*), bool indexed)
+{
+    if(heap == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(arity < 2) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+
+    if(gds_vector_init(&heap->_data, element_size, GDS_HEAP_DEFAULT_INITIAL_CAPACITY,
+                GDS_VEC_DEFAULT_RESIZE_FACTOR) != GDS_SUCCESS)
+        return GDS_HEAP_ERR_MALLOC_FAIL;
+
+    heap->_hole_buff = malloc(element_size);
+    if(heap->_hole_buff == NULL)
+    {
+        gds_vector_destruct(&heap->_data);
+        return GDS_HEAP_ERR_MALLOC_FAIL;
+    }
+
+    if(indexed)
+    {
+        size_t initialized = 0;
+        if(gds_vector_init(&heap->_handles, sizeof(size_t), GDS_HEAP_DEFAULT_INITIAL_CAPACITY,
+                    GDS_VEC_DEFAULT_RESIZE_FACTOR) == GDS_SUCCESS)
+            initialized++;
+        if((initialized == 1) && (gds_vector_init(&heap->_positions, sizeof(size_t),
+                        GDS_HEAP_DEFAULT_INITIAL_CAPACITY, GDS_VEC_DEFAULT_RESIZE_FACTOR) == GDS_SUCCESS))
+            initialized++;
+        if((initialized == 2) && (gds_vector_init(&heap->_free_handles, sizeof(size_t),
+                        GDS_HEAP_DEFAULT_INITIAL_CAPACITY, GDS_VEC_DEFAULT_RESIZE_FACTOR) == GDS_SUCCESS))
+            initialized++;
+
+        if(initialized < 3)
+        {
+            if(initialized >= 2) gds_vector_destruct(&heap->_positions);
+            if(initialized >= 1) gds_vector_destruct(&heap->_handles);
+            gds_vector_destruct(&heap->_data);
+            free(heap->_hole_buff);
+
+            return GDS_HEAP_ERR_MALLOC_FAIL;
+        }
+    }
+
+    heap->_compare_func = compare_func;
+    heap->_arity = arity;
+    heap->_indexed = indexed;
+
+    return GDS_SUCCESS;
+}
+
+static gds_err _gds_heap_reserve(GDSHeap* heap, size_t new_count)
+{
+    size_t capacity = heap->_data._data._capacity;
+    if(new_count <= capacity) return GDS_SUCCESS;
+
+    size_t new_capacity = (size_t)(capacity * heap->_data._resize_factor);
+    if(new_capacity < new_count) new_capacity = new_count;
+
+    // the handle tables are grown first - if growing the elements then fails, the larger tables are harmless.
+    if(heap->_indexed)
+    {
+        struct GDSVector* tables[] = { &heap->_handles, &heap->_positions, &heap->_free_handles };
+
+        size_t i;
+        for(i = 0; i < sizeof(tables) / sizeof(tables[0]); i++)
+        {
+            if(tables[i]->_data._capacity >= new_capacity) continue;
+
+            if(gds_vector_reserve(tables[i], new_capacity) != GDS_SUCCESS) return GDS_HEAP_ERR_REALLOC_FAIL;
+        }
+    }
+
+    if(gds_vector_reserve(&heap->_data, new_capacity) != GDS_SUCCESS) return GDS_HEAP_ERR_REALLOC_FAIL;
+
+    return GDS_SUCCESS;
+}
+
+static inline void* _gds_heap_at(const GDSHeap* heap, size_t pos)
+{
+    return (char*)heap->_data._data._data + (pos * heap->_data._data._element_size);
+}
+
+static size_t _gds_heap_acquire_handle(GDSHeap* heap)
+{
+    if(heap->_free_handles._data._count > 0)
+        return ((size_t*)heap->_free_handles._data._data)[--heap->_free_handles._data._count];
+
+    return heap->_positions._data._count++;
+}
+
+static void _gds_heap_release_handle(GDSHeap* heap, size_t pos)
+{
+    size_t handle = ((size_t*)heap->_handles._data._data)[pos];
+
+    ((size_t*)heap->_positions._data._data)[handle] = _GDS_HEAP_NO_POSITION;
+    ((size_t*)heap->_free_handles._data._data)[heap->_free_handles._data._count++] = handle;
+}
+
+static inline void _gds_heap_move(GDSHeap* heap, size_t dest_pos, size_t src_pos)
+{
+    memcpy(_gds_heap_at(heap, dest_pos), _gds_heap_at(heap, src_pos), heap->_data._data._element_size);
+
+    if(heap->_indexed)
+    {
+        size_t* handles = (size_t*)heap->_handles._data._data;
+
+        handles[dest_pos] = handles[src_pos];
+        ((size_t*)heap->_positions._data._data)[handles[dest_pos]] = dest_pos;
+    }
+}
+
+static void _gds_heap_sift_up(GDSHeap* heap, size_t pos)
+{
+    size_t element_size = heap->_data._data._element_size;
+    size_t arity = heap->_arity;
+    size_t handle = heap->_indexed ? ((size_t*)heap->_handles._data._data)[pos] : 0;
+
+    memcpy(heap->_hole_buff, _gds_heap_at(heap, pos), element_size);
+
+    while(pos > 0)
+    {
+        size_t parent = (pos - 1) / arity;
+        if(heap->_compare_func(heap->_hole_buff, _gds_heap_at(heap, parent)) >= 0) break;
+
+        _gds_heap_move(heap, pos, parent);
+        pos = parent;
+    }
+
+    memcpy(_gds_heap_at(heap, pos), heap->_hole_buff, element_size);
+
+    if(heap->_indexed)
+    {
+        ((size_t*)heap->_handles._data._data)[pos] = handle;
+        ((size_t*)heap->_positions._data._data)[handle] = pos;
+    }
+}
+
+static void _gds_heap_sift_down(GDSHeap* heap, size_t pos)
+{
+    size_t element_size = heap->_data._data._element_size;
+    size_t arity = heap->_arity;
+    size_t count = heap->_data._data._count;
+    size_t handle = heap->_indexed ? ((size_t*)heap->_handles._data._data)[pos] : 0;
+
+    memcpy(heap->_hole_buff, _gds_heap_at(heap, pos), element_size);
+
+    while(1)
+    {
+        size_t first_child = (pos * arity) + 1;
+        if(first_child >= count) break;
+
+        size_t last_child = first_child + arity;
+        if(last_child > count) last_child = count;
+
+        // the children of a node are adjacent, so finding the first one touches only a few cache lines.
+        size_t best = first_child;
+        void* best_data = _gds_heap_at(heap, first_child);
+
+        size_t i;
+        for(i = first_child + 1; i < last_child; i++)
+        {
+            void* child_data = _gds_heap_at(heap, i);
+            if(heap->_compare_func(child_data, best_data) < 0)
+            {
+                best = i;
+                best_data = child_data;
+            }
+        }
+
+        if(heap->_compare_func(best_data, heap->_hole_buff) >= 0) break;
+
+        _gds_heap_move(heap, pos, best);
+        pos = best;
+    }
+
+    memcpy(_gds_heap_at(heap, pos), heap->_hole_buff, element_size);
+
+    if(heap->_indexed)
+    {
+        ((size_t*)heap->_handles._data._data)[pos] = handle;
+        ((size_t*)heap->_positions._data._data)[handle] = pos;
+    }
+}
+
+static void _gds_heap_restore(GDSHeap* heap, size_t pos)
+{
+    if((pos > 0) && (heap->_compare_func(_gds_heap_at(heap, pos), _gds_heap_at(heap, (pos - 1) / heap->_arity)) < 0))
+        _gds_heap_sift_up(heap, pos);
+    else
+        _gds_heap_sift_down(heap, pos);
+}
+
+static void _gds_heap_build(GDSHeap* heap)
+{
+    size_t count = heap->_data._data._count;
+    if(count < 2) return;
+
+    size_t i = ((count - 2) / heap->_arity) + 1; // one past the last node with children.
+    while(i > 0) _gds_heap_sift_down(heap, --i);
+}
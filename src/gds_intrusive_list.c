@@ -0,0 +1,233 @@
+#include <stdlib.h>
+
+#include "gds.h"
+#include "gds_intrusive_list.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_INTRUSIVE_LIST_DEF_ALLOW__
+#include "def/gds_intrusive_list_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_init(GDSIntrusiveList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveList* gds_intrusive_list_create()
+{
+    GDSIntrusiveList* list = (GDSIntrusiveList*)malloc(sizeof(GDSIntrusiveList));
+    if(list == NULL) return NULL;
+
+    gds_intrusive_list_init(list);
+
+    return list;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_intrusive_list_destruct(GDSIntrusiveList* list)
+{
+    if(list == NULL) return;
+
+    gds_intrusive_list_empty(list);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_push_back(GDSIntrusiveList* list, GDSIntrusiveListNode* node)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(node == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    node->next = NULL;
+
+    if(list->_count == 0) list->_head = node;
+    else list->_tail->next = node;
+
+    list->_tail = node;
+    list->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_push_front(GDSIntrusiveList* list, GDSIntrusiveListNode* node)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(node == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    node->next = list->_head;
+
+    if(list->_count == 0) list->_tail = node;
+
+    list->_head = node;
+    list->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_insert_after(GDSIntrusiveList* list, GDSIntrusiveListNode* pos, GDSIntrusiveListNode* node)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(node == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    node->next = pos->next;
+    pos->next = node;
+
+    if(pos == list->_tail) list->_tail = node;
+
+    list->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveListNode* gds_intrusive_list_pop_front(GDSIntrusiveList* list)
+{
+    if(list == NULL) return NULL;
+    if(list->_count == 0) return NULL;
+
+    GDSIntrusiveListNode* node = list->_head;
+
+    list->_head = node->next;
+    if(list->_head == NULL) list->_tail = NULL;
+
+    list->_count--;
+
+    node->next = NULL;
+
+    return node;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveListNode* gds_intrusive_list_remove_after(GDSIntrusiveList* list, GDSIntrusiveListNode* pos)
+{
+    if(list == NULL) return NULL;
+    if(pos == NULL) return NULL;
+    if(pos == list->_tail) return NULL;
+
+    GDSIntrusiveListNode* node = pos->next;
+
+    pos->next = node->next;
+    if(node == list->_tail) list->_tail = pos;
+
+    list->_count--;
+
+    node->next = NULL;
+
+    return node;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_remove(GDSIntrusiveList* list, GDSIntrusiveListNode* node)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(node == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(list->_count == 0) return GDS_INTRLIST_ERR_NODE_NOT_FOUND;
+
+    if(node == list->_head)
+    {
+        gds_intrusive_list_pop_front(list);
+        return GDS_SUCCESS;
+    }
+
+    GDSIntrusiveListNode* prev = list->_head;
+    while((prev != list->_tail) && (prev->next != node)) prev = prev->next;
+
+    if(prev == list->_tail) return GDS_INTRLIST_ERR_NODE_NOT_FOUND;
+
+    gds_intrusive_list_remove_after(list, prev);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_splice_back(GDSIntrusiveList* dest, GDSIntrusiveList* src)
+{
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(dest == src) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    if(src->_count == 0) return GDS_SUCCESS;
+
+    if(dest->_count == 0) dest->_head = src->_head;
+    else dest->_tail->next = src->_head;
+
+    dest->_tail = src->_tail;
+    dest->_count += src->_count;
+
+    src->_head = NULL;
+    src->_tail = NULL;
+    src->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_intrusive_list_empty(GDSIntrusiveList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveListNode* gds_intrusive_list_front(const GDSIntrusiveList* list)
+{
+    return (list != NULL) ? list->_head : NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveListNode* gds_intrusive_list_back(const GDSIntrusiveList* list)
+{
+    return (list != NULL) ? list->_tail : NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_intrusive_list_get_count(const GDSIntrusiveList* list)
+{
+    return (list != NULL) ? list->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_intrusive_list_is_empty(const GDSIntrusiveList* list)
+{
+    if(list == NULL) return true;
+
+    return (list->_count == 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_intrusive_list_get_struct_size()
+{
+    return sizeof(GDSIntrusiveList);
+}
@@ -0,0 +1,689 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "gds.h"
+#include "gds_misc.h"
+#include "gds_slab.h"
+#include "gds_list.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_LIST_DEF_ALLOW__
+#include "def/gds_list_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+typedef struct _GDSListNode _GDSListNode;
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Allocates a node from the list's slab and copies 'data' into it. The node isn't linked. Returns NULL if it fails.
+ * The function assumes that 'list' is non-NULL and 'data' is non-NULL. */
+static _GDSListNode* _gds_list_alloc_node(GDSList* list, const void* data);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns address of node with index 'pos', walking from the closer end of the list. Function assumes non-NULL 'list'
+ * argument and that 'pos' is in bounds ('pos' < list->_count). */
+static _GDSListNode* _gds_list_at_node(const GDSList* list, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Links the unlinked 'node' right before 'next', or at the end of the list if 'next' is NULL. Increments the count.
+ * Assumes non-NULL 'list' and 'node'. */
+static void _gds_list_link_before(GDSList* list, _GDSListNode* next, _GDSListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks 'node' from the list, without releasing it. Decrements the count. Assumes non-NULL arguments. */
+static void _gds_list_unlink(GDSList* list, _GDSListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks 'node', calls list->_on_element_removal_func for its data if non-NULL, and returns the node to the list's
+ * slab. Assumes non-NULL arguments. */
+static void _gds_list_remove_node(GDSList* list, _GDSListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function assumes non-NULL 'list' argument. Returns the slab the list's nodes are allocated from. */
+static GDSSlab* _gds_list_get_slab(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Calls list->_on_element_removal_func for every element, if non-NULL, and releases all nodes. If the list has its
+ * own slab, its chunks are freed at once instead of freeing nodes one by one. The function assumes non-NULL 'list'
+ * argument. */
+static void _gds_list_release_all(GDSList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function assumes non-NULL 'node' argument. It returns the address of node's data. */
+static void* _gds_list_get_data_for_node(_GDSListNode* node);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Function assumes non-NULL 'data' argument, the address of an element. It returns the node holding the element. */
+static _GDSListNode* _gds_list_get_node_for_data(void* data);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_init(GDSList* list, size_t data_size, void (*_on_element_removal_func)(void*))
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    list->_count = 0;
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_data_size = data_size;
+    list->_on_element_removal_func = _on_element_removal_func;
+    list->_shared_slab = NULL;
+
+    gds_err slab_init_status = gds_slab_init(&list->_own_slab, gds_list_get_node_size(data_size), 0);
+    if(slab_init_status != GDS_SUCCESS) return GDS_GEN_ERR_INTERNAL_ERR;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_init_shared(GDSList* list, size_t data_size, void (*_on_element_removal_func)(void*), GDSSlab* slab)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(slab == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(gds_slab_get_object_size(slab) < gds_list_get_node_size(data_size)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    gds_err init_status = gds_list_init(list, data_size, _on_element_removal_func);
+    if(init_status != GDS_SUCCESS) return init_status;
+
+    list->_shared_slab = slab;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSList* gds_list_create(size_t data_size, void (*_on_element_removal_func)(void*))
+{
+    GDSList* list = (GDSList*)malloc(sizeof(GDSList));
+    if(list == NULL) return NULL;
+
+    gds_err init_status = gds_list_init(list, data_size, _on_element_removal_func);
+
+    if(init_status != GDS_SUCCESS)
+    {
+        free(list);
+        return NULL;
+    }
+    else return list;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSList* gds_list_create_shared(size_t data_size, void (*_on_element_removal_func)(void*), GDSSlab* slab)
+{
+    GDSList* list = (GDSList*)malloc(sizeof(GDSList));
+    if(list == NULL) return NULL;
+
+    gds_err init_status = gds_list_init_shared(list, data_size, _on_element_removal_func, slab);
+
+    if(init_status != GDS_SUCCESS)
+    {
+        free(list);
+        return NULL;
+    }
+    else return list;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_list_destruct(GDSList* list)
+{
+    if(list == NULL) return;
+
+    _gds_list_release_all(list);
+    gds_slab_destruct(&list->_own_slab);
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_data_size = 0;
+    list->_count = 0;
+    list->_on_element_removal_func = NULL;
+    list->_shared_slab = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_list_at(const GDSList* list, size_t pos)
+{
+    if(list == NULL) return NULL;
+    if(pos >= list->_count) return NULL;
+
+    return _gds_list_get_data_for_node(_gds_list_at_node(list, pos));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_list_front(const GDSList* list)
+{
+    if(list == NULL) return NULL;
+    if(list->_count == 0) return NULL;
+
+    return _gds_list_get_data_for_node(list->_head);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_list_back(const GDSList* list)
+{
+    if(list == NULL) return NULL;
+    if(list->_count == 0) return NULL;
+
+    return _gds_list_get_data_for_node(list->_tail);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_assign(GDSList* list, const void* data, size_t pos)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos >= list->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    memcpy(gds_list_at(list, pos), data, list->_data_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_swap(GDSList* list, size_t pos1, size_t pos2, void* swap_buff)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos1 >= list->_count) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos2 >= list->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(swap_buff == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+
+    if(pos1 == pos2) return GDS_SUCCESS;
+
+    gds_misc_swap(gds_list_at(list, pos1), gds_list_at(list, pos2), swap_buff, list->_data_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_push_back(GDSList* list, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _GDSListNode* new = _gds_list_alloc_node(list, data);
+    if(new == NULL) return GDS_LIST_ERR_MALLOC_FAIL;
+
+    _gds_list_link_before(list, NULL, new);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_push_front(GDSList* list, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _GDSListNode* new = _gds_list_alloc_node(list, data);
+    if(new == NULL) return GDS_LIST_ERR_MALLOC_FAIL;
+
+    _gds_list_link_before(list, list->_head, new);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_insert_at(GDSList* list, const void* data, size_t pos)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos > list->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    _GDSListNode* new = _gds_list_alloc_node(list, data);
+    if(new == NULL) return GDS_LIST_ERR_MALLOC_FAIL;
+
+    _GDSListNode* next = (pos < list->_count) ? _gds_list_at_node(list, pos) : NULL;
+    _gds_list_link_before(list, next, new);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_insert_before(GDSList* list, GDSListIterator* iterator, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    _GDSListNode* new = _gds_list_alloc_node(list, data);
+    if(new == NULL) return GDS_LIST_ERR_MALLOC_FAIL;
+
+    _gds_list_link_before(list, iterator->_curr_node, new);
+    iterator->_pos++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_insert_after(GDSList* list, GDSListIterator* iterator, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    _GDSListNode* new = _gds_list_alloc_node(list, data);
+    if(new == NULL) return GDS_LIST_ERR_MALLOC_FAIL;
+
+    _gds_list_link_before(list, iterator->_curr_node->next, new);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_pop_front(GDSList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list->_count == 0) return GDS_LIST_ERR_LIST_EMPTY;
+
+    _gds_list_remove_node(list, list->_head);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_pop_back(GDSList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list->_count == 0) return GDS_LIST_ERR_LIST_EMPTY;
+
+    _gds_list_remove_node(list, list->_tail);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_remove_at(GDSList* list, size_t pos)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= list->_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _gds_list_remove_node(list, _gds_list_at_node(list, pos));
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_remove(GDSList* list, void* element)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _gds_list_remove_node(list, _gds_list_get_node_for_data(element));
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_erase(GDSList* list, GDSListIterator* iterator)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    _GDSListNode* node = iterator->_curr_node;
+    iterator->_curr_node = node->next;
+
+    _gds_list_remove_node(list, node);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_move_to_front(GDSList* list, void* element)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _GDSListNode* node = _gds_list_get_node_for_data(element);
+    if(node == list->_head) return GDS_SUCCESS;
+
+    _gds_list_unlink(list, node);
+    _gds_list_link_before(list, list->_head, node);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_move_to_back(GDSList* list, void* element)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _GDSListNode* node = _gds_list_get_node_for_data(element);
+    if(node == list->_tail) return GDS_SUCCESS;
+
+    _gds_list_unlink(list, node);
+    _gds_list_link_before(list, NULL, node);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_empty(GDSList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    _gds_list_release_all(list);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_list_get_data_size(const GDSList* list)
+{
+    return (list != NULL) ? list->_data_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_list_get_count(const GDSList* list)
+{
+    return (list != NULL) ? list->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_list_is_empty(const GDSList* list)
+{
+    if(list == NULL) return true;
+
+    return (list->_count == 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_list_get_node_size(size_t data_size)
+{
+    return (sizeof(_GDSListNode) + data_size);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_list_get_struct_size()
+{
+    return sizeof(GDSList);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_iterator_init(GDSList* list, GDSListIterator* iterator)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(list->_count == 0) return GDS_LIST_ERR_LIST_EMPTY;
+
+    iterator->_curr_node = list->_head;
+    iterator->_pos = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_iterator_init_back(GDSList* list, GDSListIterator* iterator)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(list->_count == 0) return GDS_LIST_ERR_LIST_EMPTY;
+
+    iterator->_curr_node = list->_tail;
+    iterator->_pos = list->_count - 1;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSListIterator* gds_list_iterator_create(GDSList* list)
+{
+    if(list == NULL) return NULL;
+
+    GDSListIterator* iterator = (GDSListIterator*)malloc(sizeof(GDSListIterator));
+    if(iterator == NULL) return NULL;
+
+    gds_err init_status = gds_list_iterator_init(list, iterator);
+
+    if(init_status != GDS_SUCCESS)
+    {
+        free(iterator);
+        return NULL;
+    }
+    else return iterator;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_iterator_next(GDSListIterator* iterator)
+{
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    if(iterator->_curr_node->next == NULL) return GDS_LIST_ITER_ERR_OUT_OF_BOUNDS;
+
+    iterator->_curr_node = iterator->_curr_node->next;
+    iterator->_pos++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_list_iterator_prev(GDSListIterator* iterator)
+{
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    if(iterator->_curr_node->prev == NULL) return GDS_LIST_ITER_ERR_OUT_OF_BOUNDS;
+
+    iterator->_curr_node = iterator->_curr_node->prev;
+    iterator->_pos--;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_list_iterator_has_next(GDSListIterator* iterator)
+{
+    if(iterator == NULL) return false;
+    if(iterator->_curr_node == NULL) return false;
+
+    return (iterator->_curr_node->next != NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_list_iterator_has_prev(GDSListIterator* iterator)
+{
+    if(iterator == NULL) return false;
+    if(iterator->_curr_node == NULL) return false;
+
+    return (iterator->_curr_node->prev != NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_list_iterator_get_data(GDSListIterator* iterator)
+{
+    if(iterator == NULL) return NULL;
+    if(iterator->_curr_node == NULL) return NULL;
+
+    return _gds_list_get_data_for_node(iterator->_curr_node);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_list_iterator_get_pos(GDSListIterator* iterator)
+{
+    return (iterator != NULL) ? iterator->_pos : 0;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static _GDSListNode* _gds_list_alloc_node(GDSList* list, const void* data)
+{
+    assert(list != NULL);
+    assert(data != NULL);
+
+    _GDSListNode* node = (_GDSListNode*)gds_slab_alloc(_gds_list_get_slab(list));
+    if(node == NULL) return NULL;
+
+    node->prev = NULL;
+    node->next = NULL;
+
+    memcpy(_gds_list_get_data_for_node(node), data, list->_data_size);
+
+    return node;
+}
+
+static _GDSListNode* _gds_list_at_node(const GDSList* list, size_t pos)
+{
+    assert(list != NULL);
+    assert(pos < list->_count);
+
+    _GDSListNode* it;
+    size_t i;
+
+    if(pos < (list->_count / 2))
+    {
+        it = list->_head;
+        for(i = 0; i < pos; i++) it = it->next;
+    }
+    else
+    {
+        it = list->_tail;
+        for(i = list->_count - 1; i > pos; i--) it = it->prev;
+    }
+
+    return it;
+}
+
+static void _gds_list_link_before(GDSList* list, _GDSListNode* next, _GDSListNode* node)
+{
+    assert(list != NULL);
+    assert(node != NULL);
+
+    _GDSListNode* prev = (next != NULL) ? next->prev : list->_tail;
+
+    node->prev = prev;
+    node->next = next;
+
+    if(prev != NULL) prev->next = node;
+    else list->_head = node;
+
+    if(next != NULL) next->prev = node;
+    else list->_tail = node;
+
+    list->_count++;
+}
+
+static void _gds_list_unlink(GDSList* list, _GDSListNode* node)
+{
+    assert(list != NULL);
+    assert(node != NULL);
+    assert(list->_count > 0);
+
+    if(node->prev != NULL) node->prev->next = node->next;
+    else list->_head = node->next;
+
+    if(node->next != NULL) node->next->prev = node->prev;
+    else list->_tail = node->prev;
+
+    list->_count--;
+}
+
+static void _gds_list_remove_node(GDSList* list, _GDSListNode* node)
+{
+    assert(list != NULL);
+    assert(node != NULL);
+
+    _gds_list_unlink(list, node);
+
+    if(list->_on_element_removal_func != NULL)
+        list->_on_element_removal_func(_gds_list_get_data_for_node(node));
+
+    gds_slab_free(_gds_list_get_slab(list), node);
+}
+
+static GDSSlab* _gds_list_get_slab(GDSList* list)
+{
+    assert(list != NULL);
+
+    return (list->_shared_slab != NULL) ? list->_shared_slab : &list->_own_slab;
+}
+
+static void _gds_list_release_all(GDSList* list)
+{
+    assert(list != NULL);
+
+    if(list->_shared_slab != NULL)
+    {
+        while(list->_count != 0) _gds_list_remove_node(list, list->_head);
+        return;
+    }
+
+    if(list->_on_element_removal_func != NULL)
+    {
+        _GDSListNode* it;
+        for(it = list->_head; it != NULL; it = it->next)
+            list->_on_element_removal_func(_gds_list_get_data_for_node(it));
+    }
+
+    // the slab starts over from a small chunk, so an emptied list doesn't hold on to memory.
+    gds_slab_destruct(&list->_own_slab);
+    gds_slab_init(&list->_own_slab, gds_list_get_node_size(list->_data_size), 0);
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_count = 0;
+}
+
+static void* _gds_list_get_data_for_node(_GDSListNode* node)
+{
+    assert(node != NULL);
+
+    return ((char*)node + sizeof(_GDSListNode));
+}
+
+static _GDSListNode* _gds_list_get_node_for_data(void* data)
+{
+    assert(data != NULL);
+
+    return (_GDSListNode*)((char*)data - sizeof(_GDSListNode));
+}
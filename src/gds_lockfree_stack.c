@@ -0,0 +1,222 @@
+#include "gds.h"
+#include "gds_lockfree_stack.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_LOCKFREE_STACK_DEF_ALLOW__
+#include "def/gds_lockfree_stack_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+/* Where the compiler provides a double-width compare-and-swap(on x86-64, with -mcx16), it is used directly on
+ * the head reinterpreted as one integer. Elsewhere, the generic __atomic_compare_exchange() is used, which may be
+ * implemented by libatomic. */
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && (UINTPTR_MAX == UINT64_MAX)
+#define _GDS_LOCKFREE_STACK_NATIVE_DWCAS
+#endif
+
+typedef struct _GDSLockFreeStackHead _GDSLockFreeStackHead;
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Reads the head of the stack. The tag and the top are read one after another, not together - if they don't match,
+ * the following compare-and-swap fails and the head is read again. */
+static inline _GDSLockFreeStackHead _gds_lockfree_stack_load_head(const GDSLockFreeStack* stack);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Replaces the head with 'desired' if it still equals '*expected'. Otherwise, stores the current head in '*expected'.
+ * Returns true if the head was replaced. */
+static inline bool _gds_lockfree_stack_cas_head(GDSLockFreeStack* stack, _GDSLockFreeStackHead* expected,
+        _GDSLockFreeStackHead desired);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_lockfree_stack_init(GDSLockFreeStack* stack)
+{
+    if(stack == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    stack->_head.top = NULL;
+    stack->_head.tag = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSLockFreeStack* gds_lockfree_stack_create()
+{
+    GDSLockFreeStack* stack = (GDSLockFreeStack*)aligned_alloc(GDS_CACHE_LINE_SIZE, sizeof(GDSLockFreeStack));
+    if(stack == NULL) return NULL;
+
+    gds_lockfree_stack_init(stack);
+
+    return stack;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_lockfree_stack_destruct(GDSLockFreeStack* stack)
+{
+    if(stack == NULL) return;
+
+    stack->_head.top = NULL;
+    stack->_head.tag = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_lockfree_stack_push(GDSLockFreeStack* stack, GDSIntrusiveListNode* node)
+{
+    if(stack == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(node == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _GDSLockFreeStackHead old_head = _gds_lockfree_stack_load_head(stack);
+    _GDSLockFreeStackHead new_head;
+
+    do
+    {
+        // poppers may read 'next' concurrently, if they still see an old copy of this node on top.
+        __atomic_store_n(&node->next, old_head.top, __ATOMIC_RELAXED);
+
+        new_head.top = node;
+        new_head.tag = old_head.tag + 1;
+    }
+    while(!_gds_lockfree_stack_cas_head(stack, &old_head, new_head));
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_lockfree_stack_push_list(GDSLockFreeStack* stack, GDSIntrusiveList* list)
+{
+    if(stack == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(gds_intrusive_list_is_empty(list)) return GDS_SUCCESS;
+
+    GDSIntrusiveListNode* first = gds_intrusive_list_front(list);
+    GDSIntrusiveListNode* last = gds_intrusive_list_back(list);
+
+    _GDSLockFreeStackHead old_head = _gds_lockfree_stack_load_head(stack);
+    _GDSLockFreeStackHead new_head;
+
+    do
+    {
+        __atomic_store_n(&last->next, old_head.top, __ATOMIC_RELAXED);
+
+        new_head.top = first;
+        new_head.tag = old_head.tag + 1;
+    }
+    while(!_gds_lockfree_stack_cas_head(stack, &old_head, new_head));
+
+    gds_intrusive_list_empty(list);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveListNode* gds_lockfree_stack_pop(GDSLockFreeStack* stack)
+{
+    if(stack == NULL) return NULL;
+
+    _GDSLockFreeStackHead old_head = _gds_lockfree_stack_load_head(stack);
+    _GDSLockFreeStackHead new_head;
+
+    while(old_head.top != NULL)
+    {
+        // the top may be popped and reused by another thread meanwhile - then 'next' is garbage, but the tag has
+        // changed and the compare-and-swap fails.
+        new_head.top = __atomic_load_n(&old_head.top->next, __ATOMIC_RELAXED);
+        new_head.tag = old_head.tag + 1;
+
+        if(_gds_lockfree_stack_cas_head(stack, &old_head, new_head)) return old_head.top;
+    }
+
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_lockfree_stack_pop_all(GDSLockFreeStack* stack, GDSIntrusiveList* out)
+{
+    if(stack == NULL) return 0;
+    if(out == NULL) return 0;
+
+    _GDSLockFreeStackHead old_head = _gds_lockfree_stack_load_head(stack);
+    _GDSLockFreeStackHead new_head;
+
+    do
+    {
+        if(old_head.top == NULL) return 0;
+
+        new_head.top = NULL;
+        new_head.tag = old_head.tag + 1;
+    }
+    while(!_gds_lockfree_stack_cas_head(stack, &old_head, new_head));
+
+    // the detached chain belongs to this thread only.
+    GDSIntrusiveListNode* node = old_head.top;
+    size_t count = 0;
+    while(node != NULL)
+    {
+        GDSIntrusiveListNode* next = node->next;
+        gds_intrusive_list_push_back(out, node);
+        node = next;
+        count++;
+    }
+
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_lockfree_stack_is_empty(const GDSLockFreeStack* stack)
+{
+    if(stack == NULL) return true;
+
+    return (__atomic_load_n(&stack->_head.top, __ATOMIC_RELAXED) == NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_lockfree_stack_get_struct_size()
+{
+    return sizeof(GDSLockFreeStack);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static inline _GDSLockFreeStackHead _gds_lockfree_stack_load_head(const GDSLockFreeStack* stack)
+{
+    _GDSLockFreeStackHead head;
+
+    head.tag = __atomic_load_n(&stack->_head.tag, __ATOMIC_ACQUIRE);
+    head.top = __atomic_load_n(&stack->_head.top, __ATOMIC_ACQUIRE);
+
+    return head;
+}
+
+static inline bool _gds_lockfree_stack_cas_head(GDSLockFreeStack* stack, _GDSLockFreeStackHead* expected,
+        _GDSLockFreeStackHead desired)
+{
+#ifdef _GDS_LOCKFREE_STACK_NATIVE_DWCAS
+    union { _GDSLockFreeStackHead head; unsigned __int128 value; } expected_value, desired_value, current_value;
+
+    expected_value.head = *expected;
+    desired_value.head = desired;
+
+    current_value.value = __sync_val_compare_and_swap((unsigned __int128*)&stack->_head, expected_value.value,
+            desired_value.value);
+
+    if(current_value.value == expected_value.value) return true;
+
+    *expected = current_value.head;
+    return false;
+#else
+    return __atomic_compare_exchange(&stack->_head, expected, &desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif // _GDS_LOCKFREE_STACK_NATIVE_DWCAS
+}
@@ -0,0 +1,291 @@
+#include "gds.h"
+#include "gds_mpmc_queue.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_MPMC_QUEUE_DEF_ALLOW__
+#include "def/gds_mpmc_queue_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Returns the sequence number of the cell for position 'pos'. A cell whose sequence number equals 'pos' is free for
+ * the producer that claims 'pos'. A sequence number of 'pos' + 1 means the element for 'pos' is ready for the
+ * consumer that claims 'pos'. After reading, the consumer sets it to 'pos' + capacity - free for the next lap. */
+static inline atomic_size_t* _gds_mpmc_queue_sequence(const GDSMPMCQueue* queue, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element stored in the cell for position 'pos'. */
+static inline void* _gds_mpmc_queue_element(const GDSMPMCQueue* queue, size_t pos);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_mpmc_queue_init(GDSMPMCQueue* queue, size_t element_size, size_t capacity)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(capacity == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    size_t rounded_capacity = 2;
+    while(rounded_capacity < capacity) rounded_capacity <<= 1;
+
+    // elements follow the sequence number, aligned like the sequence number itself.
+    size_t cell_size = sizeof(atomic_size_t) + element_size;
+    cell_size = (cell_size + sizeof(atomic_size_t) - 1) & ~(sizeof(atomic_size_t) - 1);
+
+    size_t cells_size = rounded_capacity * cell_size;
+    cells_size = (cells_size + GDS_CACHE_LINE_SIZE - 1) & ~((size_t)GDS_CACHE_LINE_SIZE - 1);
+
+    queue->_cells = aligned_alloc(GDS_CACHE_LINE_SIZE, cells_size);
+    if(queue->_cells == NULL) return GDS_MPMC_ERR_MALLOC_FAIL;
+
+    queue->_capacity = rounded_capacity;
+    queue->_element_size = element_size;
+    queue->_cell_size = cell_size;
+
+    size_t i;
+    for(i = 0; i < rounded_capacity; i++) atomic_init(_gds_mpmc_queue_sequence(queue, i), i);
+
+    atomic_init(&queue->_enqueue_pos, 0);
+    atomic_init(&queue->_dequeue_pos, 0);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSMPMCQueue* gds_mpmc_queue_create(size_t element_size, size_t capacity)
+{
+    GDSMPMCQueue* queue = (GDSMPMCQueue*)aligned_alloc(GDS_CACHE_LINE_SIZE, sizeof(GDSMPMCQueue));
+    if(queue == NULL) return NULL;
+
+    gds_err init_status = gds_mpmc_queue_init(queue, element_size, capacity);
+
+    if(init_status == GDS_SUCCESS) return queue;
+    else
+    {
+        free(queue);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_mpmc_queue_destruct(GDSMPMCQueue* queue)
+{
+    if(queue == NULL) return;
+
+    free(queue->_cells);
+
+    queue->_cells = NULL;
+    queue->_capacity = 0;
+    queue->_element_size = 0;
+    queue->_cell_size = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_mpmc_queue_enqueue(GDSMPMCQueue* queue, const void* data)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t pos = atomic_load_explicit(&queue->_enqueue_pos, memory_order_relaxed);
+    atomic_size_t* sequence;
+    intptr_t diff;
+
+    while(true)
+    {
+        sequence = _gds_mpmc_queue_sequence(queue, pos);
+        diff = (intptr_t)atomic_load_explicit(sequence, memory_order_acquire) - (intptr_t)pos;
+
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&queue->_enqueue_pos, &pos, pos + 1,
+                        memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if(diff < 0) return GDS_MPMC_ERR_QUEUE_FULL; // the cell still holds the element from the previous lap
+        else pos = atomic_load_explicit(&queue->_enqueue_pos, memory_order_relaxed);
+    }
+
+    memcpy(_gds_mpmc_queue_element(queue, pos), data, queue->_element_size);
+    atomic_store_explicit(sequence, pos + 1, memory_order_release);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_mpmc_queue_dequeue(GDSMPMCQueue* queue, void* out)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(out == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t pos = atomic_load_explicit(&queue->_dequeue_pos, memory_order_relaxed);
+    atomic_size_t* sequence;
+    intptr_t diff;
+
+    while(true)
+    {
+        sequence = _gds_mpmc_queue_sequence(queue, pos);
+        diff = (intptr_t)atomic_load_explicit(sequence, memory_order_acquire) - (intptr_t)(pos + 1);
+
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&queue->_dequeue_pos, &pos, pos + 1,
+                        memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if(diff < 0) return GDS_MPMC_ERR_QUEUE_EMPTY; // the element for 'pos' hasn't been written yet
+        else pos = atomic_load_explicit(&queue->_dequeue_pos, memory_order_relaxed);
+    }
+
+    memcpy(out, _gds_mpmc_queue_element(queue, pos), queue->_element_size);
+    atomic_store_explicit(sequence, pos + queue->_capacity, memory_order_release);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpmc_queue_enqueue_n(GDSMPMCQueue* queue, const void* data, size_t count)
+{
+    if(queue == NULL) return 0;
+    if(data == NULL) return 0;
+    if(count == 0) return 0;
+
+    size_t pos = atomic_load_explicit(&queue->_enqueue_pos, memory_order_relaxed);
+    size_t claimed, seq;
+
+    while(true)
+    {
+        // count the free cells from 'pos' onward. A cell that is free for its position can only be written by the
+        // producer that claims the position, so the cells stay free once the claim below succeeds.
+        claimed = 0;
+        while(claimed < count)
+        {
+            seq = atomic_load_explicit(_gds_mpmc_queue_sequence(queue, pos + claimed), memory_order_acquire);
+            if(seq != pos + claimed) break;
+            claimed++;
+        }
+
+        if(claimed == 0)
+        {
+            if((intptr_t)seq - (intptr_t)pos < 0) return 0;
+            pos = atomic_load_explicit(&queue->_enqueue_pos, memory_order_relaxed);
+            continue;
+        }
+
+        if(atomic_compare_exchange_weak_explicit(&queue->_enqueue_pos, &pos, pos + claimed,
+                    memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+
+    size_t i;
+    for(i = 0; i < claimed; i++)
+    {
+        memcpy(_gds_mpmc_queue_element(queue, pos + i), (const char*)data + (i * queue->_element_size),
+                queue->_element_size);
+        atomic_store_explicit(_gds_mpmc_queue_sequence(queue, pos + i), pos + i + 1, memory_order_release);
+    }
+
+    return claimed;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpmc_queue_dequeue_n(GDSMPMCQueue* queue, void* out, size_t max_count)
+{
+    if(queue == NULL) return 0;
+    if(out == NULL) return 0;
+    if(max_count == 0) return 0;
+
+    size_t pos = atomic_load_explicit(&queue->_dequeue_pos, memory_order_relaxed);
+    size_t claimed, seq;
+
+    while(true)
+    {
+        // count the ready cells from 'pos' onward - like in gds_mpmc_queue_enqueue_n(), only the consumer that
+        // claims a ready cell's position can change it.
+        claimed = 0;
+        while(claimed < max_count)
+        {
+            seq = atomic_load_explicit(_gds_mpmc_queue_sequence(queue, pos + claimed), memory_order_acquire);
+            if(seq != pos + claimed + 1) break;
+            claimed++;
+        }
+
+        if(claimed == 0)
+        {
+            if((intptr_t)seq - (intptr_t)(pos + 1) < 0) return 0;
+            pos = atomic_load_explicit(&queue->_dequeue_pos, memory_order_relaxed);
+            continue;
+        }
+
+        if(atomic_compare_exchange_weak_explicit(&queue->_dequeue_pos, &pos, pos + claimed,
+                    memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+
+    size_t i;
+    for(i = 0; i < claimed; i++)
+    {
+        memcpy((char*)out + (i * queue->_element_size), _gds_mpmc_queue_element(queue, pos + i),
+                queue->_element_size);
+        atomic_store_explicit(_gds_mpmc_queue_sequence(queue, pos + i), pos + i + queue->_capacity,
+                memory_order_release);
+    }
+
+    return claimed;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpmc_queue_get_count(const GDSMPMCQueue* queue)
+{
+    if(queue == NULL) return 0;
+
+    size_t dequeue_pos = atomic_load_explicit(&((GDSMPMCQueue*)queue)->_dequeue_pos, memory_order_relaxed);
+    size_t enqueue_pos = atomic_load_explicit(&((GDSMPMCQueue*)queue)->_enqueue_pos, memory_order_relaxed);
+
+    return (enqueue_pos >= dequeue_pos) ? (enqueue_pos - dequeue_pos) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpmc_queue_get_capacity(const GDSMPMCQueue* queue)
+{
+    return (queue != NULL) ? queue->_capacity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpmc_queue_get_element_size(const GDSMPMCQueue* queue)
+{
+    return (queue != NULL) ? queue->_element_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpmc_queue_get_struct_size()
+{
+    return sizeof(GDSMPMCQueue);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static inline atomic_size_t* _gds_mpmc_queue_sequence(const GDSMPMCQueue* queue, size_t pos)
+{
+    return (atomic_size_t*)((char*)queue->_cells + ((pos & (queue->_capacity - 1)) * queue->_cell_size));
+}
+
+static inline void* _gds_mpmc_queue_element(const GDSMPMCQueue* queue, size_t pos)
+{
+    return (char*)_gds_mpmc_queue_sequence(queue, pos) + sizeof(atomic_size_t);
+}
@@ -0,0 +1,168 @@
+#include "gds.h"
+#include "gds_mpsc_queue.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_MPSC_QUEUE_DEF_ALLOW__
+#include "def/gds_mpsc_queue_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Appends the chain of nodes from 'first' to 'last' to the queue. The nodes between them must already be linked. The
+ * exchange makes 'last' the new head at once. Only then is the chain linked after the previous head - until that
+ * store, the consumer sees the queue end at the previous head. */
+static inline void _gds_mpsc_queue_link(GDSMPSCQueue* queue, GDSIntrusiveListNode* first, GDSIntrusiveListNode* last);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_mpsc_queue_init(GDSMPSCQueue* queue)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    queue->_stub.next = NULL;
+    queue->_tail = &queue->_stub;
+    atomic_init(&queue->_head, &queue->_stub);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSMPSCQueue* gds_mpsc_queue_create()
+{
+    GDSMPSCQueue* queue = (GDSMPSCQueue*)aligned_alloc(GDS_CACHE_LINE_SIZE, sizeof(GDSMPSCQueue));
+    if(queue == NULL) return NULL;
+
+    gds_mpsc_queue_init(queue);
+
+    return queue;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_mpsc_queue_destruct(GDSMPSCQueue* queue)
+{
+    if(queue == NULL) return;
+
+    gds_mpsc_queue_init(queue);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_mpsc_queue_push(GDSMPSCQueue* queue, GDSIntrusiveListNode* node)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(node == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    _gds_mpsc_queue_link(queue, node, node);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_mpsc_queue_push_list(GDSMPSCQueue* queue, GDSIntrusiveList* list)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(gds_intrusive_list_is_empty(list)) return GDS_SUCCESS;
+
+    _gds_mpsc_queue_link(queue, gds_intrusive_list_front(list), gds_intrusive_list_back(list));
+
+    gds_intrusive_list_empty(list);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSIntrusiveListNode* gds_mpsc_queue_pop(GDSMPSCQueue* queue)
+{
+    if(queue == NULL) return NULL;
+
+    GDSIntrusiveListNode* tail = queue->_tail;
+    GDSIntrusiveListNode* next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+
+    // the stub is never handed out - skip it.
+    if(tail == &queue->_stub)
+    {
+        if(next == NULL) return NULL;
+
+        queue->_tail = next;
+        tail = next;
+        next = __atomic_load_n(&next->next, __ATOMIC_ACQUIRE);
+    }
+
+    if(next != NULL)
+    {
+        queue->_tail = next;
+        return tail;
+    }
+
+    // 'tail' is the last linked node. If it isn't the head, a producer has swapped in a newer head but hasn't linked
+    // it yet.
+    GDSIntrusiveListNode* head = atomic_load_explicit(&queue->_head, memory_order_acquire);
+    if(tail != head) return NULL;
+
+    // 'tail' is the only node. Pushing the stub behind it lets 'tail' be popped without leaving the queue without
+    // nodes.
+    _gds_mpsc_queue_link(queue, &queue->_stub, &queue->_stub);
+
+    next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    if(next != NULL)
+    {
+        queue->_tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpsc_queue_pop_all(GDSMPSCQueue* queue, GDSIntrusiveList* out)
+{
+    if(queue == NULL) return 0;
+    if(out == NULL) return 0;
+
+    size_t count = 0;
+    GDSIntrusiveListNode* node;
+    while((node = gds_mpsc_queue_pop(queue)) != NULL)
+    {
+        gds_intrusive_list_push_back(out, node);
+        count++;
+    }
+
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_mpsc_queue_is_empty(const GDSMPSCQueue* queue)
+{
+    if(queue == NULL) return true;
+
+    return (queue->_tail == &queue->_stub) && (__atomic_load_n(&queue->_stub.next, __ATOMIC_ACQUIRE) == NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_mpsc_queue_get_struct_size()
+{
+    return sizeof(GDSMPSCQueue);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static inline void _gds_mpsc_queue_link(GDSMPSCQueue* queue, GDSIntrusiveListNode* first, GDSIntrusiveListNode* last)
+{
+    __atomic_store_n(&last->next, NULL, __ATOMIC_RELAXED);
+
+    GDSIntrusiveListNode* prev = atomic_exchange_explicit(&queue->_head, last, memory_order_acq_rel);
+
+    __atomic_store_n(&prev->next, first, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,901 @@
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_vector.h"
+#include "gds_pool.h"
+#include "gds_parallel.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "def/gds_vector_def.h"
+#define __GDS_POOL_DEF_ALLOW__
+#include "def/gds_pool_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Count of threads set by gds_parallel_set_thread_count(). 0 means the default count. */
+static atomic_size_t _gds_parallel_thread_count = 0;
+
+/* Pool set by gds_parallel_set_pool(). NULL means that threads are started for each call. */
+static _Atomic(GDSPool*) _gds_parallel_pool = NULL;
+
+/* Elements of an array, split into chunks. */
+struct _GDSParallelRange
+{
+    char* data;
+    size_t count;
+    size_t element_size;
+    size_t chunk_size; // count of elements in each chunk, except the last one,
+    size_t chunk_count;
+};
+
+/* A set of tasks, indexed 0 .. 'task_count' - 1, run by _gds_parallel_run(). */
+struct _GDSParallelJob
+{
+    void (*task)(size_t task_index, void* ctx);
+    void* ctx;
+    size_t task_count;
+    atomic_size_t next_task;
+};
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Runs 'task' for each index in [0, 'task_count'). Up to gds_parallel_get_thread_count() - 1 helpers are started -
+ * as threads, or as tasks of the pool set by gds_parallel_set_pool() - and the calling thread takes part as well.
+ * Indices are handed out one at a time, so uneven tasks are balanced. If threads can't be started, the remaining
+ * tasks are simply run by the threads that were started. Returns when all tasks are done. */
+static void _gds_parallel_run(size_t task_count, void (*task)(size_t task_index, void* ctx), void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Thread function for _gds_parallel_run(). Takes task indices from the job until there are none left. */
+static void* _gds_parallel_worker(void* job);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pool task function for _gds_parallel_run(). Calls _gds_parallel_worker(). */
+static void _gds_parallel_pool_worker(void* job);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Splits the elements of 'array' into chunks. A chunk holds about GDS_PAR_CHUNK_BYTES bytes, rounded up to a whole
+ * number of cache lines. */
+static struct _GDSParallelRange _gds_parallel_range(const GDSArray* array);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Stores the index of the first element and the count of elements of chunk 'chunk_index'. */
+static inline void _gds_parallel_chunk(const struct _GDSParallelRange* range, size_t chunk_index,
+        size_t* first, size_t* count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Task functions for the algorithms below. Each one processes the chunk with index 'task_index'. */
+static void _gds_parallel_for_each_task(size_t task_index, void* ctx);
+static void _gds_parallel_transform_task(size_t task_index, void* ctx);
+static void _gds_parallel_reduce_task(size_t task_index, void* ctx);
+static void _gds_parallel_scan_task(size_t task_index, void* ctx);
+static void _gds_parallel_partition_count_task(size_t task_index, void* ctx);
+static void _gds_parallel_partition_scatter_task(size_t task_index, void* ctx);
+static void _gds_parallel_copy_task(size_t task_index, void* ctx);
+static void _gds_parallel_sort_run_task(size_t task_index, void* ctx);
+static void _gds_parallel_merge_task(size_t task_index, void* ctx);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Shared implementation of gds_parallel_array_inclusive_scan() and gds_parallel_array_exclusive_scan(). */
+static gds_err _gds_parallel_scan(GDSArray* array, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx, bool inclusive);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the count of elements of 'a'(of length 'a_count') among the first 'k' elements of the merge of sorted 'a'
+ * and 'b'(of length 'b_count'). Equal elements are taken from 'a' first. Found with a binary search, so that
+ * a merge can be split into independent parts. */
+static size_t _gds_parallel_co_rank(const char* a, size_t a_count, const char* b, size_t b_count, size_t k,
+        size_t element_size, int (*compare_func)(const void*, const void*));
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+struct _GDSParallelForEachCtx
+{
+    struct _GDSParallelRange range;
+    void (*func)(void* element, void* ctx);
+    void* ctx;
+};
+
+struct _GDSParallelTransformCtx
+{
+    struct _GDSParallelRange range;
+    char* dest;
+    size_t dest_element_size;
+    void (*func)(const void* element, void* out, void* ctx);
+    void* ctx;
+};
+
+struct _GDSParallelReduceCtx
+{
+    struct _GDSParallelRange range;
+    char* partials; // one value of 'result_size' bytes per chunk,
+    size_t result_size;
+    const void* identity;
+    void (*accumulate)(void* acc, const void* element, void* ctx);
+    void* ctx;
+};
+
+struct _GDSParallelScanCtx
+{
+    struct _GDSParallelRange range;
+    char* offsets; // combination of the elements before each chunk, one element per chunk,
+    char* temps; // scratch element per chunk,
+    void (*op)(void* acc, const void* element, void* ctx);
+    void* ctx;
+    bool inclusive;
+};
+
+struct _GDSParallelPartitionCtx
+{
+    struct _GDSParallelRange range;
+    char* buffer;
+    size_t* true_counts; // count of elements for which 'pred' is true, per chunk,
+    size_t* true_offsets; // where each chunk's true and false elements go in 'buffer',
+    size_t* false_offsets;
+    bool (*pred)(const void* element, void* ctx);
+    void* ctx;
+};
+
+struct _GDSParallelCopyCtx
+{
+    struct _GDSParallelRange range; // destination,
+    const char* src;
+};
+
+struct _GDSParallelSortCtx
+{
+    char* data;
+    size_t count;
+    size_t element_size;
+    size_t run_size; // count of elements in each sorted run, except the last one,
+    int (*compare_func)(const void*, const void*);
+};
+
+struct _GDSParallelMergeCtx
+{
+    const char* src;
+    char* dest;
+    size_t count;
+    size_t element_size;
+    size_t width; // count of elements in each of the sorted runs being merged pairwise,
+    size_t part_size; // count of output elements each task produces,
+    int (*compare_func)(const void*, const void*);
+};
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+void gds_parallel_set_thread_count(size_t thread_count)
+{
+    atomic_store_explicit(&_gds_parallel_thread_count, thread_count, memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_parallel_get_thread_count()
+{
+    size_t thread_count = atomic_load_explicit(&_gds_parallel_thread_count, memory_order_relaxed);
+    if(thread_count != 0) return thread_count;
+
+    GDSPool* pool = atomic_load_explicit(&_gds_parallel_pool, memory_order_acquire);
+    if(pool != NULL) return gds_pool_get_thread_count(pool) + 1;
+
+    long online_count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (online_count > 0) ? (size_t)online_count : 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_parallel_set_pool(GDSPool* pool)
+{
+    atomic_store_explicit(&_gds_parallel_pool, pool, memory_order_release);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSPool* gds_parallel_get_pool()
+{
+    return atomic_load_explicit(&_gds_parallel_pool, memory_order_acquire);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_for_each(GDSArray* array, void (*func)(void* element, void* ctx), void* ctx)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(func == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSParallelForEachCtx for_each_ctx = {
+        .range = _gds_parallel_range(array),
+        .func = func,
+        .ctx = ctx
+    };
+
+    _gds_parallel_run(for_each_ctx.range.chunk_count, _gds_parallel_for_each_task, &for_each_ctx);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_transform(const GDSArray* src, GDSArray* dest,
+        void (*func)(const void* element, void* out, void* ctx), void* ctx)
+{
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(func == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(dest->_capacity < src->_count) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    struct _GDSParallelTransformCtx transform_ctx = {
+        .range = _gds_parallel_range(src),
+        .dest = (char*)dest->_data,
+        .dest_element_size = dest->_element_size,
+        .func = func,
+        .ctx = ctx
+    };
+
+    _gds_parallel_run(transform_ctx.range.chunk_count, _gds_parallel_transform_task, &transform_ctx);
+
+    dest->_count = src->_count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_reduce(const GDSArray* array, void* result, size_t result_size, const void* identity,
+        void (*accumulate)(void* acc, const void* element, void* ctx),
+        void (*combine)(void* acc, const void* other, void* ctx), void* ctx)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(result == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(result_size == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(identity == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(accumulate == NULL) return GDS_GEN_ERR_INVALID_ARG(5);
+    if(combine == NULL) return GDS_GEN_ERR_INVALID_ARG(6);
+
+    struct _GDSParallelReduceCtx reduce_ctx = {
+        .range = _gds_parallel_range(array),
+        .result_size = result_size,
+        .identity = identity,
+        .accumulate = accumulate,
+        .ctx = ctx
+    };
+
+    memcpy(result, identity, result_size);
+    if(reduce_ctx.range.chunk_count == 0) return GDS_SUCCESS;
+
+    reduce_ctx.partials = (char*)malloc(reduce_ctx.range.chunk_count * result_size);
+    if(reduce_ctx.partials == NULL) return GDS_PAR_ERR_MALLOC_FAIL;
+
+    _gds_parallel_run(reduce_ctx.range.chunk_count, _gds_parallel_reduce_task, &reduce_ctx);
+
+    size_t i;
+    for(i = 0; i < reduce_ctx.range.chunk_count; i++)
+        combine(result, reduce_ctx.partials + (i * result_size), ctx);
+
+    free(reduce_ctx.partials);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_inclusive_scan(GDSArray* array, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx)
+{
+    return _gds_parallel_scan(array, identity, op, ctx, true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_exclusive_scan(GDSArray* array, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx)
+{
+    return _gds_parallel_scan(array, identity, op, ctx, false);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_stable_partition(GDSArray* array, bool (*pred)(const void* element, void* ctx), void* ctx,
+        size_t* out_true_count)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pred == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSParallelPartitionCtx partition_ctx = {
+        .range = _gds_parallel_range(array),
+        .pred = pred,
+        .ctx = ctx
+    };
+
+    size_t chunk_count = partition_ctx.range.chunk_count;
+    if(chunk_count == 0)
+    {
+        if(out_true_count != NULL) *out_true_count = 0;
+        return GDS_SUCCESS;
+    }
+
+    partition_ctx.buffer = (char*)malloc(array->_count * array->_element_size);
+    partition_ctx.true_counts = (size_t*)malloc(3 * chunk_count * sizeof(size_t));
+    if((partition_ctx.buffer == NULL) || (partition_ctx.true_counts == NULL))
+    {
+        free(partition_ctx.buffer);
+        free(partition_ctx.true_counts);
+        return GDS_PAR_ERR_MALLOC_FAIL;
+    }
+    partition_ctx.true_offsets = partition_ctx.true_counts + chunk_count;
+    partition_ctx.false_offsets = partition_ctx.true_offsets + chunk_count;
+
+    _gds_parallel_run(chunk_count, _gds_parallel_partition_count_task, &partition_ctx);
+
+    size_t total_true = 0;
+    size_t i;
+    for(i = 0; i < chunk_count; i++) total_true += partition_ctx.true_counts[i];
+
+    size_t true_offset = 0, false_offset = total_true;
+    size_t first, count;
+    for(i = 0; i < chunk_count; i++)
+    {
+        _gds_parallel_chunk(&partition_ctx.range, i, &first, &count);
+
+        partition_ctx.true_offsets[i] = true_offset;
+        partition_ctx.false_offsets[i] = false_offset;
+        true_offset += partition_ctx.true_counts[i];
+        false_offset += count - partition_ctx.true_counts[i];
+    }
+
+    _gds_parallel_run(chunk_count, _gds_parallel_partition_scatter_task, &partition_ctx);
+
+    struct _GDSParallelCopyCtx copy_ctx = {
+        .range = partition_ctx.range,
+        .src = partition_ctx.buffer
+    };
+
+    _gds_parallel_run(chunk_count, _gds_parallel_copy_task, &copy_ctx);
+
+    free(partition_ctx.buffer);
+    free(partition_ctx.true_counts);
+
+    if(out_true_count != NULL) *out_true_count = total_true;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_array_sort(GDSArray* array, int (*compare_func)(const void*, const void*))
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSParallelRange range = _gds_parallel_range(array);
+    size_t run_count = gds_parallel_get_thread_count();
+    if(run_count > range.chunk_count) run_count = range.chunk_count;
+
+    if(run_count <= 1) return gds_array_sort(array, compare_func);
+
+    struct _GDSParallelSortCtx sort_ctx = {
+        .data = range.data,
+        .count = range.count,
+        .element_size = range.element_size,
+        .run_size = (range.count + run_count - 1) / run_count,
+        .compare_func = compare_func
+    };
+
+    char* buffer = (char*)malloc(range.count * range.element_size);
+    if(buffer == NULL) return GDS_PAR_ERR_MALLOC_FAIL;
+
+    _gds_parallel_run(run_count, _gds_parallel_sort_run_task, &sort_ctx);
+
+    struct _GDSParallelMergeCtx merge_ctx = {
+        .src = range.data,
+        .dest = buffer,
+        .count = range.count,
+        .element_size = range.element_size,
+        .width = sort_ctx.run_size,
+        .part_size = range.chunk_size,
+        .compare_func = compare_func
+    };
+
+    // each pass merges pairs of runs of 'width' elements from 'src' into 'dest', then the buffers switch roles.
+    size_t part_count = range.chunk_count;
+    while(merge_ctx.width < range.count)
+    {
+        _gds_parallel_run(part_count, _gds_parallel_merge_task, &merge_ctx);
+
+        const char* merged = merge_ctx.dest;
+        merge_ctx.dest = (char*)merge_ctx.src;
+        merge_ctx.src = merged;
+        merge_ctx.width *= 2;
+    }
+
+    if(merge_ctx.src != range.data)
+    {
+        struct _GDSParallelCopyCtx copy_ctx = {
+            .range = range,
+            .src = merge_ctx.src
+        };
+
+        _gds_parallel_run(range.chunk_count, _gds_parallel_copy_task, &copy_ctx);
+    }
+
+    free(buffer);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_for_each(GDSVector* vector, void (*func)(void* element, void* ctx), void* ctx)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_parallel_array_for_each(&vector->_data, func, ctx);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_transform(const GDSVector* src, GDSVector* dest,
+        void (*func)(const void* element, void* out, void* ctx), void* ctx)
+{
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(gds_vector_get_capacity(dest) < gds_vector_get_count(src))
+    {
+        gds_err reserve_status = gds_vector_reserve(dest, gds_vector_get_count(src));
+        if(reserve_status != GDS_SUCCESS) return reserve_status;
+    }
+
+    return gds_parallel_array_transform(&src->_data, &dest->_data, func, ctx);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_reduce(const GDSVector* vector, void* result, size_t result_size, const void* identity,
+        void (*accumulate)(void* acc, const void* element, void* ctx),
+        void (*combine)(void* acc, const void* other, void* ctx), void* ctx)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_parallel_array_reduce(&vector->_data, result, result_size, identity, accumulate, combine, ctx);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_inclusive_scan(GDSVector* vector, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_parallel_array_inclusive_scan(&vector->_data, identity, op, ctx);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_exclusive_scan(GDSVector* vector, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_parallel_array_exclusive_scan(&vector->_data, identity, op, ctx);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_stable_partition(GDSVector* vector, bool (*pred)(const void* element, void* ctx),
+        void* ctx, size_t* out_true_count)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_parallel_array_stable_partition(&vector->_data, pred, ctx, out_true_count);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_parallel_vector_sort(GDSVector* vector, int (*compare_func)(const void*, const void*))
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_parallel_array_sort(&vector->_data, compare_func);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static void _gds_parallel_run(size_t task_count, void (*task)(size_t task_index, void* ctx), void* ctx)
+{
+    if(task_count == 0) return;
+
+    size_t thread_count = gds_parallel_get_thread_count();
+    if(thread_count > task_count) thread_count = task_count;
+
+    if(thread_count <= 1)
+    {
+        size_t i;
+        for(i = 0; i < task_count; i++) task(i, ctx);
+        return;
+    }
+
+    struct _GDSParallelJob job = {
+        .task = task,
+        .ctx = ctx,
+        .task_count = task_count
+    };
+    atomic_init(&job.next_task, 0);
+
+    GDSPool* pool = atomic_load_explicit(&_gds_parallel_pool, memory_order_acquire);
+    if(pool != NULL)
+    {
+        GDSPoolGroup group;
+        gds_pool_group_init(&group);
+
+        size_t i;
+        for(i = 0; i < (thread_count - 1); i++) gds_pool_submit(pool, &group, _gds_parallel_pool_worker, &job);
+
+        _gds_parallel_worker(&job);
+        gds_pool_group_wait(pool, &group);
+
+        return;
+    }
+
+    pthread_t* threads = (pthread_t*)malloc((thread_count - 1) * sizeof(pthread_t));
+    size_t started_count = 0;
+
+    if(threads != NULL)
+    {
+        while(started_count < (thread_count - 1))
+        {
+            if(pthread_create(&threads[started_count], NULL, _gds_parallel_worker, &job) != 0) break;
+            started_count++;
+        }
+    }
+
+    _gds_parallel_worker(&job);
+
+    size_t i;
+    for(i = 0; i < started_count; i++) pthread_join(threads[i], NULL);
+
+    free(threads);
+}
+
+static void* _gds_parallel_worker(void* job)
+{
+    struct _GDSParallelJob* _job = (struct _GDSParallelJob*)job;
+    size_t task_index;
+
+    while(true)
+    {
+        task_index = atomic_fetch_add_explicit(&_job->next_task, 1, memory_order_relaxed);
+        if(task_index >= _job->task_count) break;
+
+        _job->task(task_index, _job->ctx);
+    }
+
+    return NULL;
+}
+
+static void _gds_parallel_pool_worker(void* job)
+{
+    _gds_parallel_worker(job);
+}
+
+static struct _GDSParallelRange _gds_parallel_range(const GDSArray* array)
+{
+    struct _GDSParallelRange range;
+    range.data = (char*)array->_data;
+    range.count = array->_count;
+    range.element_size = array->_element_size;
+
+    // smallest count of elements that takes up a whole number of cache lines.
+    size_t line_elements = GDS_CACHE_LINE_SIZE;
+    size_t a = GDS_CACHE_LINE_SIZE, b = range.element_size % GDS_CACHE_LINE_SIZE, t;
+    while(b != 0)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    line_elements /= a;
+
+    range.chunk_size = (GDS_PAR_CHUNK_BYTES + range.element_size - 1) / range.element_size;
+    range.chunk_size = ((range.chunk_size + line_elements - 1) / line_elements) * line_elements;
+    range.chunk_count = (range.count + range.chunk_size - 1) / range.chunk_size;
+
+    return range;
+}
+
+static inline void _gds_parallel_chunk(const struct _GDSParallelRange* range, size_t chunk_index,
+        size_t* first, size_t* count)
+{
+    *first = chunk_index * range->chunk_size;
+    *count = ((range->count - *first) < range->chunk_size) ? (range->count - *first) : range->chunk_size;
+}
+
+static void _gds_parallel_for_each_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelForEachCtx* _ctx = (struct _GDSParallelForEachCtx*)ctx;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    char* it = _ctx->range.data + (first * _ctx->range.element_size);
+    char* end = it + (count * _ctx->range.element_size);
+    for(; it < end; it += _ctx->range.element_size) _ctx->func(it, _ctx->ctx);
+}
+
+static void _gds_parallel_transform_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelTransformCtx* _ctx = (struct _GDSParallelTransformCtx*)ctx;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    const char* src = _ctx->range.data + (first * _ctx->range.element_size);
+    char* dest = _ctx->dest + (first * _ctx->dest_element_size);
+    size_t i;
+    for(i = 0; i < count; i++)
+    {
+        _ctx->func(src, dest, _ctx->ctx);
+        src += _ctx->range.element_size;
+        dest += _ctx->dest_element_size;
+    }
+}
+
+static void _gds_parallel_reduce_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelReduceCtx* _ctx = (struct _GDSParallelReduceCtx*)ctx;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    char* acc = _ctx->partials + (task_index * _ctx->result_size);
+    memcpy(acc, _ctx->identity, _ctx->result_size);
+
+    const char* it = _ctx->range.data + (first * _ctx->range.element_size);
+    const char* end = it + (count * _ctx->range.element_size);
+    for(; it < end; it += _ctx->range.element_size) _ctx->accumulate(acc, it, _ctx->ctx);
+}
+
+static void _gds_parallel_scan_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelScanCtx* _ctx = (struct _GDSParallelScanCtx*)ctx;
+    size_t element_size = _ctx->range.element_size;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    char* acc = _ctx->offsets + (task_index * element_size);
+    char* temp = _ctx->temps + (task_index * element_size);
+    char* it = _ctx->range.data + (first * element_size);
+    char* end = it + (count * element_size);
+
+    if(_ctx->inclusive)
+    {
+        for(; it < end; it += element_size)
+        {
+            _ctx->op(acc, it, _ctx->ctx);
+            memcpy(it, acc, element_size);
+        }
+    }
+    else
+    {
+        for(; it < end; it += element_size)
+        {
+            memcpy(temp, it, element_size);
+            memcpy(it, acc, element_size);
+            _ctx->op(acc, temp, _ctx->ctx);
+        }
+    }
+}
+
+static void _gds_parallel_partition_count_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelPartitionCtx* _ctx = (struct _GDSParallelPartitionCtx*)ctx;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    size_t true_count = 0;
+    const char* it = _ctx->range.data + (first * _ctx->range.element_size);
+    const char* end = it + (count * _ctx->range.element_size);
+    for(; it < end; it += _ctx->range.element_size)
+        if(_ctx->pred(it, _ctx->ctx)) true_count++;
+
+    _ctx->true_counts[task_index] = true_count;
+}
+
+static void _gds_parallel_partition_scatter_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelPartitionCtx* _ctx = (struct _GDSParallelPartitionCtx*)ctx;
+    size_t element_size = _ctx->range.element_size;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    char* true_dest = _ctx->buffer + (_ctx->true_offsets[task_index] * element_size);
+    char* false_dest = _ctx->buffer + (_ctx->false_offsets[task_index] * element_size);
+
+    const char* it = _ctx->range.data + (first * element_size);
+    const char* end = it + (count * element_size);
+    for(; it < end; it += element_size)
+    {
+        if(_ctx->pred(it, _ctx->ctx))
+        {
+            memcpy(true_dest, it, element_size);
+            true_dest += element_size;
+        }
+        else
+        {
+            memcpy(false_dest, it, element_size);
+            false_dest += element_size;
+        }
+    }
+}
+
+static void _gds_parallel_copy_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelCopyCtx* _ctx = (struct _GDSParallelCopyCtx*)ctx;
+    size_t first, count;
+    _gds_parallel_chunk(&_ctx->range, task_index, &first, &count);
+
+    size_t offset = first * _ctx->range.element_size;
+    memcpy(_ctx->range.data + offset, _ctx->src + offset, count * _ctx->range.element_size);
+}
+
+static void _gds_parallel_sort_run_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelSortCtx* _ctx = (struct _GDSParallelSortCtx*)ctx;
+
+    size_t first = task_index * _ctx->run_size;
+    if(first >= _ctx->count) return;
+    size_t count = ((_ctx->count - first) < _ctx->run_size) ? (_ctx->count - first) : _ctx->run_size;
+
+    // the run is sorted through a GDSArray that views the run's part of the buffer.
+    GDSArray run = {
+        ._count = count,
+        ._capacity = count,
+        ._element_size = _ctx->element_size,
+        ._data = _ctx->data + (first * _ctx->element_size),
+        ._storage = GDS_ARR_STORAGE_HEAP,
+        ._mapped_size = 0,
+        ._fd = -1
+    };
+
+    gds_array_sort(&run, _ctx->compare_func);
+}
+
+static void _gds_parallel_merge_task(size_t task_index, void* ctx)
+{
+    struct _GDSParallelMergeCtx* _ctx = (struct _GDSParallelMergeCtx*)ctx;
+    size_t element_size = _ctx->element_size;
+
+    size_t out_first = task_index * _ctx->part_size;
+    size_t out_end = ((_ctx->count - out_first) < _ctx->part_size) ? _ctx->count : (out_first + _ctx->part_size);
+
+    // the part of the output may span several pairs of runs - each overlapped pair is merged separately.
+    size_t pair_first, a_count, b_count, k_first, k_end, a_pos, b_pos, a_end, b_end;
+    const char *a, *b;
+    char* out;
+    while(out_first < out_end)
+    {
+        pair_first = out_first - (out_first % (2 * _ctx->width));
+        a_count = ((_ctx->count - pair_first) < _ctx->width) ? (_ctx->count - pair_first) : _ctx->width;
+        b_count = ((_ctx->count - pair_first - a_count) < _ctx->width) ?
+            (_ctx->count - pair_first - a_count) : _ctx->width;
+
+        a = _ctx->src + (pair_first * element_size);
+        b = a + (a_count * element_size);
+
+        k_first = out_first - pair_first;
+        k_end = ((out_end - pair_first) < (a_count + b_count)) ? (out_end - pair_first) : (a_count + b_count);
+
+        a_pos = _gds_parallel_co_rank(a, a_count, b, b_count, k_first, element_size, _ctx->compare_func);
+        b_pos = k_first - a_pos;
+        a_end = _gds_parallel_co_rank(a, a_count, b, b_count, k_end, element_size, _ctx->compare_func);
+        b_end = k_end - a_end;
+
+        out = _ctx->dest + (out_first * element_size);
+        while((a_pos < a_end) && (b_pos < b_end))
+        {
+            if(_ctx->compare_func(b + (b_pos * element_size), a + (a_pos * element_size)) < 0)
+            {
+                memcpy(out, b + (b_pos * element_size), element_size);
+                b_pos++;
+            }
+            else
+            {
+                memcpy(out, a + (a_pos * element_size), element_size);
+                a_pos++;
+            }
+            out += element_size;
+        }
+
+        memcpy(out, a + (a_pos * element_size), (a_end - a_pos) * element_size);
+        out += (a_end - a_pos) * element_size;
+        memcpy(out, b + (b_pos * element_size), (b_end - b_pos) * element_size);
+
+        out_first = pair_first + k_end;
+    }
+}
+
+static gds_err _gds_parallel_scan(GDSArray* array, const void* identity,
+        void (*op)(void* acc, const void* element, void* ctx), void* ctx, bool inclusive)
+{
+    if(array == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(identity == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(op == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    struct _GDSParallelScanCtx scan_ctx = {
+        .range = _gds_parallel_range(array),
+        .op = op,
+        .ctx = ctx,
+        .inclusive = inclusive
+    };
+
+    size_t chunk_count = scan_ctx.range.chunk_count;
+    size_t element_size = scan_ctx.range.element_size;
+    if(chunk_count == 0) return GDS_SUCCESS;
+
+    scan_ctx.offsets = (char*)malloc(2 * chunk_count * element_size);
+    if(scan_ctx.offsets == NULL) return GDS_PAR_ERR_MALLOC_FAIL;
+    scan_ctx.temps = scan_ctx.offsets + (chunk_count * element_size);
+
+    // chunk totals are stored into 'temps', then turned into offsets - the combination of all preceding chunks.
+    if(chunk_count > 1)
+    {
+        struct _GDSParallelReduceCtx reduce_ctx = {
+            .range = scan_ctx.range,
+            .partials = scan_ctx.temps,
+            .result_size = element_size,
+            .identity = identity,
+            .accumulate = op,
+            .ctx = ctx
+        };
+
+        reduce_ctx.range.chunk_count--; // the last chunk's total isn't needed,
+        _gds_parallel_run(reduce_ctx.range.chunk_count, _gds_parallel_reduce_task, &reduce_ctx);
+    }
+
+    memcpy(scan_ctx.offsets, identity, element_size);
+
+    size_t i;
+    for(i = 1; i < chunk_count; i++)
+    {
+        memcpy(scan_ctx.offsets + (i * element_size), scan_ctx.offsets + ((i - 1) * element_size), element_size);
+        op(scan_ctx.offsets + (i * element_size), scan_ctx.temps + ((i - 1) * element_size), ctx);
+    }
+
+    _gds_parallel_run(chunk_count, _gds_parallel_scan_task, &scan_ctx);
+
+    free(scan_ctx.offsets);
+
+    return GDS_SUCCESS;
+}
+
+static size_t _gds_parallel_co_rank(const char* a, size_t a_count, const char* b, size_t b_count, size_t k,
+        size_t element_size, int (*compare_func)(const void*, const void*))
+{
+    size_t low = (k > b_count) ? (k - b_count) : 0;
+    size_t high = (k < a_count) ? k : a_count;
+    size_t mid;
+
+    // find the first 'i' for which a[i] must come after b[k - i - 1].
+    while(low < high)
+    {
+        mid = low + ((high - low) / 2);
+
+        if(compare_func(a + (mid * element_size), b + ((k - mid - 1) * element_size)) <= 0) low = mid + 1;
+        else high = mid;
+    }
+
+    return low;
+}
@@ -0,0 +1,519 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif // __linux__
+
+#include "gds.h"
+#include "gds_mpmc_queue.h"
+#include "gds_pool.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_POOL_DEF_ALLOW__
+#include "def/gds_pool_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+/* Count of unsuccessful attempts to find a task before a worker(or a waiting thread) goes to sleep. */
+#define _GDS_POOL_SPIN_COUNT 64
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+struct _GDSPoolTask
+{
+    void (*func)(void* ctx);
+    void* ctx;
+    struct GDSPoolGroup* group;
+};
+
+/* Worker the current thread is, NULL for threads that are not workers of any pool. */
+static _Thread_local struct _GDSPoolWorker* _gds_pool_current_worker = NULL;
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Thread function of a worker. Runs tasks until the pool is stopped and no tasks are left. */
+static void* _gds_pool_worker_main(void* worker);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Stops and joins the first 'started_count' workers, then frees the pool's memory. Used by gds_pool_destruct() and
+ * on failed initialization. */
+static void _gds_pool_shutdown(GDSPool* pool, size_t started_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pushes the task to the bottom of 'worker's deque. Only called by the owner of the deque.
+ * Return value: true if the task was pushed, false if the deque is full. */
+static bool _gds_pool_deque_push(struct _GDSPoolWorker* worker, const struct _GDSPoolTask* task);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Pops a task from the bottom of 'worker's deque. Only called by the owner of the deque.
+ * Return value: true if a task was popped into 'task', false if the deque is empty. */
+static bool _gds_pool_deque_pop(struct _GDSPoolWorker* worker, struct _GDSPoolTask* task);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Steals a task from the top of 'victim's deque. May be called by any thread.
+ * Return value: true if a task was stolen into 'task', false if the deque is empty or another thread took the task
+ * first. */
+static bool _gds_pool_deque_steal(struct _GDSPoolWorker* victim, struct _GDSPoolTask* task);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Looks for a task to run: first in 'worker's own deque(if 'worker' is not NULL), then in the shared queue, then in
+ * other workers' deques, starting from a random one.
+ * Return value: true if a task was found and stored into 'task', false otherwise. */
+static bool _gds_pool_find_task(GDSPool* pool, struct _GDSPoolWorker* worker, struct _GDSPoolTask* task);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks whether any deque or the shared queue holds a task. */
+static bool _gds_pool_has_work(GDSPool* pool);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Runs the task and, if it belongs to a group, marks it finished. Wakes threads waiting for groups if this was
+ * the group's last task. */
+static void _gds_pool_run_task(GDSPool* pool, const struct _GDSPoolTask* task);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Wakes a sleeping worker, if there is one, after a task has been submitted. */
+static void _gds_pool_wake_worker(GDSPool* pool);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_pool_init(GDSPool* pool, size_t thread_count, const int* cpus)
+{
+    if(pool == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if((cpus != NULL) && (thread_count == 0)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+#ifndef __linux__
+    if(cpus != NULL) return GDS_POOL_ERR_AFFINITY_FAIL;
+#endif // __linux__
+
+    if(thread_count == 0)
+    {
+        long online_count = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = (online_count > 0) ? (size_t)online_count : 1;
+    }
+
+    pool->_workers = (struct _GDSPoolWorker*)aligned_alloc(GDS_CACHE_LINE_SIZE,
+            thread_count * sizeof(struct _GDSPoolWorker));
+    if(pool->_workers == NULL) return GDS_POOL_ERR_MALLOC_FAIL;
+
+    pool->_worker_count = thread_count;
+
+    size_t i;
+    for(i = 0; i < thread_count; i++)
+    {
+        struct _GDSPoolWorker* worker = &pool->_workers[i];
+
+        atomic_init(&worker->_top, 0);
+        atomic_init(&worker->_bottom, 0);
+        worker->_pool = pool;
+        worker->_rng_state = 0x9E3779B97F4A7C15ull * (i + 1);
+        worker->_slots = (struct _GDSPoolSlot*)malloc(GDS_POOL_DEQUE_CAPACITY * sizeof(struct _GDSPoolSlot));
+
+        if(worker->_slots == NULL)
+        {
+            while(i > 0) free(pool->_workers[--i]._slots);
+            free(pool->_workers);
+            return GDS_POOL_ERR_MALLOC_FAIL;
+        }
+    }
+
+    if(gds_mpmc_queue_init(&pool->_queue, sizeof(struct _GDSPoolTask), GDS_POOL_QUEUE_CAPACITY) != GDS_SUCCESS)
+    {
+        for(i = 0; i < thread_count; i++) free(pool->_workers[i]._slots);
+        free(pool->_workers);
+        return GDS_POOL_ERR_MALLOC_FAIL;
+    }
+
+    atomic_init(&pool->_stop, false);
+    atomic_init(&pool->_sleeper_count, 0);
+    atomic_init(&pool->_waiter_count, 0);
+    pthread_mutex_init(&pool->_mutex, NULL);
+    pthread_cond_init(&pool->_sleep_cond, NULL);
+    pthread_cond_init(&pool->_done_cond, NULL);
+
+    for(i = 0; i < thread_count; i++)
+    {
+        if(pthread_create(&pool->_workers[i]._thread, NULL, _gds_pool_worker_main, &pool->_workers[i]) != 0)
+        {
+            _gds_pool_shutdown(pool, i);
+            return GDS_POOL_ERR_THREAD_FAIL;
+        }
+
+#ifdef __linux__
+        if(cpus != NULL)
+        {
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(cpus[i], &cpu_set);
+
+            if(pthread_setaffinity_np(pool->_workers[i]._thread, sizeof(cpu_set_t), &cpu_set) != 0)
+            {
+                _gds_pool_shutdown(pool, i + 1);
+                return GDS_POOL_ERR_AFFINITY_FAIL;
+            }
+        }
+#endif // __linux__
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSPool* gds_pool_create(size_t thread_count, const int* cpus)
+{
+    GDSPool* pool = (GDSPool*)aligned_alloc(GDS_CACHE_LINE_SIZE, sizeof(GDSPool));
+    if(pool == NULL) return NULL;
+
+    gds_err init_status = gds_pool_init(pool, thread_count, cpus);
+
+    if(init_status == GDS_SUCCESS) return pool;
+    else
+    {
+        free(pool);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_pool_destruct(GDSPool* pool)
+{
+    if(pool == NULL) return;
+
+    _gds_pool_shutdown(pool, pool->_worker_count);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_pool_submit(GDSPool* pool, GDSPoolGroup* group, void (*func)(void* ctx), void* ctx)
+{
+    if(pool == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(func == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    struct _GDSPoolTask task = { .func = func, .ctx = ctx, .group = group };
+
+    if(group != NULL) atomic_fetch_add_explicit(&group->_pending, 1, memory_order_relaxed);
+
+    struct _GDSPoolWorker* worker = _gds_pool_current_worker;
+    bool queued;
+
+    if((worker != NULL) && (worker->_pool == pool)) queued = _gds_pool_deque_push(worker, &task);
+    else queued = (gds_mpmc_queue_enqueue(&pool->_queue, &task) == GDS_SUCCESS);
+
+    if(queued) _gds_pool_wake_worker(pool);
+    else _gds_pool_run_task(pool, &task);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_pool_group_wait(GDSPool* pool, GDSPoolGroup* group)
+{
+    if(pool == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(group == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSPoolWorker* worker = _gds_pool_current_worker;
+    if((worker != NULL) && (worker->_pool != pool)) worker = NULL;
+
+    struct _GDSPoolTask task;
+    size_t failed_count = 0;
+
+    while(atomic_load_explicit(&group->_pending, memory_order_acquire) > 0)
+    {
+        if(_gds_pool_find_task(pool, worker, &task))
+        {
+            _gds_pool_run_task(pool, &task);
+            failed_count = 0;
+        }
+        else if(failed_count < _GDS_POOL_SPIN_COUNT)
+        {
+            failed_count++;
+            sched_yield();
+        }
+        else
+        {
+            // the remaining tasks of the group are running on other threads - sleep until the last one finishes.
+            pthread_mutex_lock(&pool->_mutex);
+            atomic_fetch_add(&pool->_waiter_count, 1);
+
+            if(atomic_load(&group->_pending) > 0) pthread_cond_wait(&pool->_done_cond, &pool->_mutex);
+
+            atomic_fetch_sub(&pool->_waiter_count, 1);
+            pthread_mutex_unlock(&pool->_mutex);
+            failed_count = 0;
+        }
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_pool_get_thread_count(const GDSPool* pool)
+{
+    return (pool != NULL) ? pool->_worker_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_pool_get_struct_size()
+{
+    return sizeof(GDSPool);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_pool_group_init(GDSPoolGroup* group)
+{
+    if(group == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    atomic_init(&group->_pending, 0);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSPoolGroup* gds_pool_group_create()
+{
+    GDSPoolGroup* group = (GDSPoolGroup*)malloc(sizeof(GDSPoolGroup));
+    if(group == NULL) return NULL;
+
+    gds_pool_group_init(group);
+
+    return group;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_pool_group_get_pending_count(const GDSPoolGroup* group)
+{
+    return (group != NULL) ? atomic_load(&((GDSPoolGroup*)group)->_pending) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_pool_group_get_struct_size()
+{
+    return sizeof(GDSPoolGroup);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static void* _gds_pool_worker_main(void* worker)
+{
+    struct _GDSPoolWorker* _worker = (struct _GDSPoolWorker*)worker;
+    GDSPool* pool = _worker->_pool;
+    _gds_pool_current_worker = _worker;
+
+    struct _GDSPoolTask task;
+    size_t failed_count = 0;
+
+    while(true)
+    {
+        if(_gds_pool_find_task(pool, _worker, &task))
+        {
+            _gds_pool_run_task(pool, &task);
+            failed_count = 0;
+            continue;
+        }
+
+        if(atomic_load(&pool->_stop)) break;
+
+        if(failed_count < _GDS_POOL_SPIN_COUNT)
+        {
+            failed_count++;
+            sched_yield();
+            continue;
+        }
+
+        /* The sleeper count is incremented before checking for work, and submitters check it after queueing their
+         * task(both sequentially consistent), so either this worker sees the task or the submitter sees the
+         * sleeper. Submitters signal while holding the mutex, so the wakeup can't come between the check and
+         * the wait. */
+        pthread_mutex_lock(&pool->_mutex);
+        atomic_fetch_add(&pool->_sleeper_count, 1);
+
+        if(!atomic_load(&pool->_stop) && !_gds_pool_has_work(pool))
+            pthread_cond_wait(&pool->_sleep_cond, &pool->_mutex);
+
+        atomic_fetch_sub(&pool->_sleeper_count, 1);
+        pthread_mutex_unlock(&pool->_mutex);
+        failed_count = 0;
+    }
+
+    _gds_pool_current_worker = NULL;
+
+    return NULL;
+}
+
+static void _gds_pool_shutdown(GDSPool* pool, size_t started_count)
+{
+    pthread_mutex_lock(&pool->_mutex);
+    atomic_store(&pool->_stop, true);
+    pthread_cond_broadcast(&pool->_sleep_cond);
+    pthread_mutex_unlock(&pool->_mutex);
+
+    size_t i;
+    for(i = 0; i < started_count; i++) pthread_join(pool->_workers[i]._thread, NULL);
+
+    for(i = 0; i < pool->_worker_count; i++) free(pool->_workers[i]._slots);
+    free(pool->_workers);
+    gds_mpmc_queue_destruct(&pool->_queue);
+
+    pthread_mutex_destroy(&pool->_mutex);
+    pthread_cond_destroy(&pool->_sleep_cond);
+    pthread_cond_destroy(&pool->_done_cond);
+
+    pool->_workers = NULL;
+    pool->_worker_count = 0;
+}
+
+static bool _gds_pool_deque_push(struct _GDSPoolWorker* worker, const struct _GDSPoolTask* task)
+{
+    int64_t bottom = atomic_load_explicit(&worker->_bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&worker->_top, memory_order_acquire);
+
+    if((bottom - top) >= GDS_POOL_DEQUE_CAPACITY) return false;
+
+    struct _GDSPoolSlot* slot = &worker->_slots[bottom & (GDS_POOL_DEQUE_CAPACITY - 1)];
+    atomic_store_explicit(&slot->_func, task->func, memory_order_relaxed);
+    atomic_store_explicit(&slot->_ctx, task->ctx, memory_order_relaxed);
+    atomic_store_explicit(&slot->_group, task->group, memory_order_relaxed);
+
+    atomic_store_explicit(&worker->_bottom, bottom + 1, memory_order_release);
+
+    return true;
+}
+
+static bool _gds_pool_deque_pop(struct _GDSPoolWorker* worker, struct _GDSPoolTask* task)
+{
+    int64_t bottom = atomic_load_explicit(&worker->_bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&worker->_bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&worker->_top, memory_order_relaxed);
+
+    if(top > bottom)
+    {
+        atomic_store_explicit(&worker->_bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    struct _GDSPoolSlot* slot = &worker->_slots[bottom & (GDS_POOL_DEQUE_CAPACITY - 1)];
+    task->func = atomic_load_explicit(&slot->_func, memory_order_relaxed);
+    task->ctx = atomic_load_explicit(&slot->_ctx, memory_order_relaxed);
+    task->group = atomic_load_explicit(&slot->_group, memory_order_relaxed);
+
+    if(top == bottom)
+    {
+        // last task - race against thieves for it.
+        bool won = atomic_compare_exchange_strong_explicit(&worker->_top, &top, top + 1,
+                memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&worker->_bottom, bottom + 1, memory_order_relaxed);
+        return won;
+    }
+
+    return true;
+}
+
+static bool _gds_pool_deque_steal(struct _GDSPoolWorker* victim, struct _GDSPoolTask* task)
+{
+    int64_t top = atomic_load_explicit(&victim->_top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&victim->_bottom, memory_order_acquire);
+
+    if(top >= bottom) return false;
+
+    struct _GDSPoolSlot* slot = &victim->_slots[top & (GDS_POOL_DEQUE_CAPACITY - 1)];
+    task->func = atomic_load_explicit(&slot->_func, memory_order_relaxed);
+    task->ctx = atomic_load_explicit(&slot->_ctx, memory_order_relaxed);
+    task->group = atomic_load_explicit(&slot->_group, memory_order_relaxed);
+
+    return atomic_compare_exchange_strong_explicit(&victim->_top, &top, top + 1,
+            memory_order_seq_cst, memory_order_relaxed);
+}
+
+static bool _gds_pool_find_task(GDSPool* pool, struct _GDSPoolWorker* worker, struct _GDSPoolTask* task)
+{
+    if((worker != NULL) && _gds_pool_deque_pop(worker, task)) return true;
+
+    if(gds_mpmc_queue_dequeue(&pool->_queue, task) == GDS_SUCCESS) return true;
+
+    size_t start;
+    if(worker != NULL)
+    {
+        // xorshift64
+        worker->_rng_state ^= worker->_rng_state << 13;
+        worker->_rng_state ^= worker->_rng_state >> 7;
+        worker->_rng_state ^= worker->_rng_state << 17;
+        start = (size_t)(worker->_rng_state % pool->_worker_count);
+    }
+    else start = 0;
+
+    size_t i;
+    struct _GDSPoolWorker* victim;
+    for(i = 0; i < pool->_worker_count; i++)
+    {
+        victim = &pool->_workers[(start + i) % pool->_worker_count];
+        if(victim == worker) continue;
+
+        if(_gds_pool_deque_steal(victim, task)) return true;
+    }
+
+    return false;
+}
+
+static bool _gds_pool_has_work(GDSPool* pool)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if(gds_mpmc_queue_get_count(&pool->_queue) > 0) return true;
+
+    size_t i;
+    for(i = 0; i < pool->_worker_count; i++)
+    {
+        if(atomic_load(&pool->_workers[i]._bottom) > atomic_load(&pool->_workers[i]._top)) return true;
+    }
+
+    return false;
+}
+
+static void _gds_pool_run_task(GDSPool* pool, const struct _GDSPoolTask* task)
+{
+    task->func(task->ctx);
+
+    if(task->group == NULL) return;
+
+    if((atomic_fetch_sub_explicit(&task->group->_pending, 1, memory_order_seq_cst) == 1) &&
+            (atomic_load(&pool->_waiter_count) > 0))
+    {
+        pthread_mutex_lock(&pool->_mutex);
+        pthread_cond_broadcast(&pool->_done_cond);
+        pthread_mutex_unlock(&pool->_mutex);
+    }
+}
+
+static void _gds_pool_wake_worker(GDSPool* pool)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if(atomic_load(&pool->_sleeper_count) > 0)
+    {
+        pthread_mutex_lock(&pool->_mutex);
+        pthread_cond_signal(&pool->_sleep_cond);
+        pthread_mutex_unlock(&pool->_mutex);
+    }
+}
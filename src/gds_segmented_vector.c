@@ -0,0 +1,330 @@
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_vector.h"
+#include "gds_segmented_vector.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_SEGMENTED_VECTOR_DEF_ALLOW__
+#include "def/gds_segmented_vector_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+#define _GDS_SEGVEC_DIRECTORY_INITIAL_CAPACITY 8
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of segment 'segment_index'. The directory is read directly - the index is always in bounds,
+ * as it's computed from a position that is. Assumes non-NULL 'segvec'. */
+static inline char* _gds_segmented_vector_segment(const GDSSegmentedVector* segvec, size_t segment_index);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the element at index 'pos'. The segment holding it must be allocated. Assumes non-NULL
+ * 'segvec'. */
+static inline void* _gds_segmented_vector_slot(const GDSSegmentedVector* segvec, size_t pos);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Allocates a new segment and appends its address to the directory. Assumes non-NULL 'segvec'. */
+static gds_err _gds_segmented_vector_add_segment(GDSSegmentedVector* segvec);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_init(GDSSegmentedVector* segvec, size_t element_size, size_t segment_capacity)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(segment_capacity == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    size_t shift = 0;
+    while(((size_t)1 << shift) < segment_capacity) shift++;
+
+    segvec->_count = 0;
+    segvec->_element_size = element_size;
+    segvec->_segment_shift = shift;
+
+    gds_err init_status = gds_vector_init(&segvec->_segments, sizeof(void*),
+            _GDS_SEGVEC_DIRECTORY_INITIAL_CAPACITY, GDS_VEC_DEFAULT_RESIZE_FACTOR);
+
+    if(init_status == GDS_SUCCESS) return GDS_SUCCESS;
+    else if((init_status == GDS_VEC_ERR_MALLOC_FAIL) || (init_status == GDS_ARR_ERR_MALLOC_FAIL))
+        return GDS_SEGVEC_ERR_MALLOC_FAIL;
+    else return GDS_GEN_ERR_INTERNAL_ERR;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_init_default(GDSSegmentedVector* segvec, size_t element_size)
+{
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    // largest power of two that keeps the segment within GDS_SEGVEC_DEFAULT_SEGMENT_BYTES, at least 1.
+    size_t segment_capacity = 1;
+    while((segment_capacity * 2 * element_size) <= GDS_SEGVEC_DEFAULT_SEGMENT_BYTES) segment_capacity *= 2;
+
+    return gds_segmented_vector_init(segvec, element_size, segment_capacity);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSSegmentedVector* gds_segmented_vector_create(size_t element_size, size_t segment_capacity)
+{
+    GDSSegmentedVector* segvec = (GDSSegmentedVector*)malloc(sizeof(GDSSegmentedVector));
+    if(segvec == NULL) return NULL;
+
+    gds_err init_status = gds_segmented_vector_init(segvec, element_size, segment_capacity);
+
+    if(init_status == GDS_SUCCESS) return segvec;
+    else
+    {
+        free(segvec);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_segmented_vector_destruct(GDSSegmentedVector* segvec)
+{
+    if(segvec == NULL) return;
+
+    size_t segment_count = gds_vector_get_count(&segvec->_segments);
+    size_t i;
+    for(i = 0; i < segment_count; i++) free(_gds_segmented_vector_segment(segvec, i));
+
+    gds_vector_destruct(&segvec->_segments);
+
+    segvec->_count = 0;
+    segvec->_element_size = 0;
+    segvec->_segment_shift = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_segmented_vector_at(const GDSSegmentedVector* segvec, size_t pos)
+{
+    if(segvec == NULL) return NULL;
+    if(pos >= segvec->_count) return NULL;
+
+    return _gds_segmented_vector_slot(segvec, pos);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_assign(GDSSegmentedVector* segvec, const void* data, size_t pos)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos >= segvec->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    memcpy(_gds_segmented_vector_slot(segvec, pos), data, segvec->_element_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_push_back(GDSSegmentedVector* segvec, const void* data)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(segvec->_count == gds_segmented_vector_get_capacity(segvec))
+    {
+        gds_err add_status = _gds_segmented_vector_add_segment(segvec);
+        if(add_status != GDS_SUCCESS) return add_status;
+    }
+
+    memcpy(_gds_segmented_vector_slot(segvec, segvec->_count), data, segvec->_element_size);
+    segvec->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_push_back_n(GDSSegmentedVector* segvec, const void* data, size_t count)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    gds_err reserve_status = gds_segmented_vector_reserve(segvec, segvec->_count + count);
+    if(reserve_status != GDS_SUCCESS) return reserve_status;
+
+    size_t segment_capacity = (size_t)1 << segvec->_segment_shift;
+    const char* src = (const char*)data;
+    size_t copy_count;
+
+    while(count > 0)
+    {
+        copy_count = segment_capacity - (segvec->_count & (segment_capacity - 1));
+        if(copy_count > count) copy_count = count;
+
+        memcpy(_gds_segmented_vector_slot(segvec, segvec->_count), src, copy_count * segvec->_element_size);
+
+        segvec->_count += copy_count;
+        src += copy_count * segvec->_element_size;
+        count -= copy_count;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_pop_back(GDSSegmentedVector* segvec)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(segvec->_count == 0) return GDS_SEGVEC_ERR_SEGVEC_EMPTY;
+
+    segvec->_count--;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_empty(GDSSegmentedVector* segvec)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    segvec->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_reserve(GDSSegmentedVector* segvec, size_t new_capacity)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    gds_err add_status;
+    while(gds_segmented_vector_get_capacity(segvec) < new_capacity)
+    {
+        add_status = _gds_segmented_vector_add_segment(segvec);
+        if(add_status != GDS_SUCCESS) return add_status;
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_segmented_vector_fit(GDSSegmentedVector* segvec)
+{
+    if(segvec == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    size_t used_segment_count = gds_segmented_vector_get_segment_count(segvec);
+
+    while(gds_vector_get_count(&segvec->_segments) > used_segment_count)
+    {
+        free(_gds_segmented_vector_segment(segvec, gds_vector_get_count(&segvec->_segments) - 1));
+        gds_vector_pop_back(&segvec->_segments);
+    }
+
+    gds_vector_fit(&segvec->_segments);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_segmented_vector_get_segment(const GDSSegmentedVector* segvec, size_t segment_index, size_t* out_count)
+{
+    if(segvec == NULL) return NULL;
+    if(out_count == NULL) return NULL;
+    if(segment_index >= gds_segmented_vector_get_segment_count(segvec)) return NULL;
+
+    size_t first_pos = segment_index << segvec->_segment_shift;
+    size_t segment_capacity = (size_t)1 << segvec->_segment_shift;
+    size_t remaining = segvec->_count - first_pos;
+
+    *out_count = (remaining < segment_capacity) ? remaining : segment_capacity;
+
+    return _gds_segmented_vector_segment(segvec, segment_index);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_segmented_vector_get_count(const GDSSegmentedVector* segvec)
+{
+    return (segvec != NULL) ? segvec->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_segmented_vector_get_capacity(const GDSSegmentedVector* segvec)
+{
+    return (segvec != NULL) ? (gds_vector_get_count(&segvec->_segments) << segvec->_segment_shift) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_segmented_vector_get_segment_capacity(const GDSSegmentedVector* segvec)
+{
+    return (segvec != NULL) ? ((size_t)1 << segvec->_segment_shift) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_segmented_vector_get_segment_count(const GDSSegmentedVector* segvec)
+{
+    if(segvec == NULL) return 0;
+
+    size_t segment_capacity = (size_t)1 << segvec->_segment_shift;
+
+    return (segvec->_count + segment_capacity - 1) >> segvec->_segment_shift;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_segmented_vector_is_empty(const GDSSegmentedVector* segvec)
+{
+    return (segvec != NULL) ? (segvec->_count == 0) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_segmented_vector_get_element_size(const GDSSegmentedVector* segvec)
+{
+    return (segvec != NULL) ? segvec->_element_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_segmented_vector_get_struct_size()
+{
+    return sizeof(GDSSegmentedVector);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static inline char* _gds_segmented_vector_segment(const GDSSegmentedVector* segvec, size_t segment_index)
+{
+    return ((char**)segvec->_segments._data._data)[segment_index];
+}
+
+static inline void* _gds_segmented_vector_slot(const GDSSegmentedVector* segvec, size_t pos)
+{
+    size_t offset = pos & (((size_t)1 << segvec->_segment_shift) - 1);
+
+    return _gds_segmented_vector_segment(segvec, pos >> segvec->_segment_shift) + (offset * segvec->_element_size);
+}
+
+static gds_err _gds_segmented_vector_add_segment(GDSSegmentedVector* segvec)
+{
+    void* segment = malloc(segvec->_element_size << segvec->_segment_shift);
+    if(segment == NULL) return GDS_SEGVEC_ERR_MALLOC_FAIL;
+
+    gds_err push_status = gds_vector_push_back(&segvec->_segments, &segment);
+    if(push_status != GDS_SUCCESS)
+    {
+        free(segment);
+        return GDS_SEGVEC_ERR_MALLOC_FAIL;
+    }
+
+    return GDS_SUCCESS;
+}
@@ -0,0 +1,446 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif // __linux__
+
+#include "gds.h"
+#include "gds_vector.h"
+#include "gds_forward_list.h"
+#include "gds_serial.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_SERIAL_DEF_ALLOW__
+#include "def/gds_serial_def.h"
+#define __GDS_VECTOR_DEF_ALLOW__
+#include "def/gds_vector_def.h"
+#define __GDS_FORWARD_LIST_DEF_ALLOW__
+#include "def/gds_forward_list_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+#define _GDS_SERIAL_MAGIC "GDSSERIA"
+
+#ifdef IOV_MAX
+#define _GDS_SERIAL_IOV_BATCH IOV_MAX
+#else
+#define _GDS_SERIAL_IOV_BATCH 1024
+#endif // IOV_MAX
+
+// Header preceding the serialized elements. All fields are naturally aligned, so the struct has no padding.
+struct _GDSSerialHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t element_size;
+    uint64_t count;
+};
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Fills 'header' for 'count' elements of size 'element_size'. */
+static void _gds_serial_header_fill(struct _GDSSerialHeader* header, size_t element_size, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks the magic, version and header size of 'header', and that the elements' total size fits in size_t.
+ * Stores the element size and count into 'out_element_size' and 'out_count'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - GDS_SERIAL_ERR_FILE_INVALID. */
+static gds_err _gds_serial_header_check(const struct _GDSSerialHeader* header, size_t* out_element_size,
+        size_t* out_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Writes all buffers described by 'iov'[0 .. 'iov_count' - 1] to 'fd' with writev(). Partial writes and calls
+ * interrupted by signals are retried. Modifies the iovecs in 'iov'.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - GDS_SERIAL_ERR_WRITE_FAIL. */
+static gds_err _gds_serial_writev_all(int fd, struct iovec* iov, int iov_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Reads exactly 'size' bytes from 'fd' into 'buff'. If 'offset' is not negative, pread() is used to read from that
+ * offset, otherwise read() is used. Short reads and calls interrupted by signals are retried.
+ * Return value:
+ * on success - GDS_SUCCESS,
+ * on failure - GDS_SERIAL_ERR_READ_FAIL or GDS_SERIAL_ERR_FILE_INVALID(end of file was reached first). */
+static gds_err _gds_serial_read_all(int fd, void* buff, size_t size, off_t offset);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_serial_write_vector(int fd, const GDSVector* vector)
+{
+    if(fd < 0) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t element_size = vector->_data._element_size;
+    size_t count = vector->_data._count;
+
+    struct _GDSSerialHeader header;
+    _gds_serial_header_fill(&header, element_size, count);
+
+    struct iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = vector->_data._data;
+    iov[1].iov_len = count * element_size;
+
+    return _gds_serial_writev_all(fd, iov, (count > 0) ? 2 : 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_serial_read_vector(int fd, GDSVector* vector, size_t element_size)
+{
+    if(fd < 0) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSSerialHeader header;
+    gds_err read_status = _gds_serial_read_all(fd, &header, sizeof(header), -1);
+    if(read_status != GDS_SUCCESS) return read_status;
+
+    size_t file_element_size, count;
+    gds_err check_status = _gds_serial_header_check(&header, &file_element_size, &count);
+    if(check_status != GDS_SUCCESS) return check_status;
+
+    if((element_size != 0) && (element_size != file_element_size)) return GDS_SERIAL_ERR_ELEMENT_SIZE_MISMATCH;
+
+    gds_err init_status = gds_vector_init(vector, file_element_size, (count > 0) ? count : 1,
+            GDS_VEC_DEFAULT_RESIZE_FACTOR);
+    if(init_status != GDS_SUCCESS) return GDS_SERIAL_ERR_MALLOC_FAIL;
+
+    // the elements go straight into the buffer allocated by gds_vector_init() - no intermediate copy.
+    read_status = _gds_serial_read_all(fd, vector->_data._data, count * file_element_size, -1);
+    if(read_status != GDS_SUCCESS)
+    {
+        gds_vector_destruct(vector);
+        return read_status;
+    }
+
+    vector->_data._count = count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_serial_write_forward_list(int fd, const GDSForwardList* list)
+{
+    if(fd < 0) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSSerialHeader header;
+    _gds_serial_header_fill(&header, list->_data_size, list->_count);
+
+    struct iovec iov[_GDS_SERIAL_IOV_BATCH];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    int iov_count = 1;
+
+    // the walk is bounded by the count of elements, so the tail's next pointer is never followed.
+    GDSForwardListIterator it;
+    if(list->_count > 0) gds_forward_list_iterator_init((GDSForwardList*)list, &it);
+
+    size_t i;
+    for(i = 0; i < list->_count; i++)
+    {
+        if(i > 0) gds_forward_list_iterator_next(&it);
+
+        iov[iov_count].iov_base = gds_forward_list_iterator_get_data(&it);
+        iov[iov_count].iov_len = list->_data_size;
+        iov_count++;
+
+        if((iov_count == _GDS_SERIAL_IOV_BATCH) || (i == list->_count - 1))
+        {
+            gds_err write_status = _gds_serial_writev_all(fd, iov, iov_count);
+            if(write_status != GDS_SUCCESS) return write_status;
+
+            iov_count = 0;
+        }
+    }
+
+    // the list is empty - only the header is left to write.
+    if(iov_count > 0) return _gds_serial_writev_all(fd, iov, iov_count);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_serial_read_forward_list(int fd, GDSForwardList* list)
+{
+    if(fd < 0) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    struct _GDSSerialHeader header;
+    gds_err read_status = _gds_serial_read_all(fd, &header, sizeof(header), -1);
+    if(read_status != GDS_SUCCESS) return read_status;
+
+    size_t element_size, count;
+    gds_err check_status = _gds_serial_header_check(&header, &element_size, &count);
+    if(check_status != GDS_SUCCESS) return check_status;
+
+    if(element_size != list->_data_size) return GDS_SERIAL_ERR_ELEMENT_SIZE_MISMATCH;
+    if(count == 0) return GDS_SUCCESS;
+
+    size_t block_capacity = GDS_SERIAL_DEFAULT_BLOCK_SIZE / element_size;
+    if(block_capacity == 0) block_capacity = 1;
+    if(block_capacity > count) block_capacity = count;
+
+    char* block = (char*)malloc(block_capacity * element_size);
+    if(block == NULL) return GDS_SERIAL_ERR_MALLOC_FAIL;
+
+    gds_err status = GDS_SUCCESS;
+    size_t remaining = count;
+    while((remaining > 0) && (status == GDS_SUCCESS))
+    {
+        size_t block_count = (remaining < block_capacity) ? remaining : block_capacity;
+
+        status = _gds_serial_read_all(fd, block, block_count * element_size, -1);
+
+        size_t i;
+        for(i = 0; (i < block_count) && (status == GDS_SUCCESS); i++)
+        {
+            if(gds_forward_list_push_back(list, block + (i * element_size)) != GDS_SUCCESS)
+                status = GDS_SERIAL_ERR_MALLOC_FAIL;
+        }
+
+        remaining -= block_count;
+    }
+
+    free(block);
+
+    return status;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_serial_reader_init(GDSSerialReader* reader, int fd, size_t block_size)
+{
+    if(reader == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(fd < 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(block_size == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if(offset < 0) return GDS_SERIAL_ERR_READ_FAIL;
+
+    struct _GDSSerialHeader header;
+    gds_err read_status = _gds_serial_read_all(fd, &header, sizeof(header), offset);
+    if(read_status != GDS_SUCCESS) return read_status;
+
+    size_t element_size, count;
+    gds_err check_status = _gds_serial_header_check(&header, &element_size, &count);
+    if(check_status != GDS_SUCCESS) return check_status;
+
+    size_t block_capacity = block_size / element_size;
+    if(block_capacity == 0) block_capacity = 1;
+    if((block_capacity > count) && (count > 0)) block_capacity = count;
+
+    reader->_block = (char*)malloc(block_capacity * element_size);
+    if(reader->_block == NULL) return GDS_SERIAL_ERR_MALLOC_FAIL;
+
+    reader->_fd = fd;
+    reader->_element_size = element_size;
+    reader->_count = count;
+    reader->_remaining_count = count;
+    reader->_block_capacity = block_capacity;
+    reader->_offset = offset + (off_t)sizeof(header);
+
+    #ifdef __linux__
+    // hints only - failures are ignored.
+    posix_fadvise(fd, reader->_offset, 0, POSIX_FADV_SEQUENTIAL);
+    posix_fadvise(fd, reader->_offset, (off_t)(block_capacity * element_size), POSIX_FADV_WILLNEED);
+    #endif // __linux__
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSSerialReader* gds_serial_reader_create(int fd, size_t block_size)
+{
+    GDSSerialReader* reader = (GDSSerialReader*)malloc(sizeof(GDSSerialReader));
+    if(reader == NULL) return NULL;
+
+    gds_err init_status = gds_serial_reader_init(reader, fd, block_size);
+
+    if(init_status == GDS_SUCCESS) return reader;
+    else
+    {
+        free(reader);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_serial_reader_destruct(GDSSerialReader* reader)
+{
+    if(reader == NULL) return;
+
+    free(reader->_block);
+
+    reader->_fd = -1;
+    reader->_element_size = 0;
+    reader->_count = 0;
+    reader->_remaining_count = 0;
+    reader->_block = NULL;
+    reader->_block_capacity = 0;
+    reader->_offset = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_serial_reader_next_block(GDSSerialReader* reader, const void** out_block, size_t* out_count)
+{
+    if(reader == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(out_block == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(out_count == NULL) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    if(reader->_remaining_count == 0)
+    {
+        *out_block = reader->_block;
+        *out_count = 0;
+        return GDS_SUCCESS;
+    }
+
+    size_t block_count = (reader->_remaining_count < reader->_block_capacity) ?
+        reader->_remaining_count : reader->_block_capacity;
+    size_t block_bytes = block_count * reader->_element_size;
+
+    gds_err read_status = _gds_serial_read_all(reader->_fd, reader->_block, block_bytes, reader->_offset);
+    if(read_status != GDS_SUCCESS) return read_status;
+
+    #ifdef __linux__
+    // start reading the following block while the caller processes this one, and drop the pages that were just
+    // copied into the block buffer - they won't be read again.
+    posix_fadvise(reader->_fd, reader->_offset + (off_t)block_bytes,
+            (off_t)(reader->_block_capacity * reader->_element_size), POSIX_FADV_WILLNEED);
+    posix_fadvise(reader->_fd, reader->_offset, (off_t)block_bytes, POSIX_FADV_DONTNEED);
+    #endif // __linux__
+
+    reader->_offset += (off_t)block_bytes;
+    reader->_remaining_count -= block_count;
+
+    *out_block = reader->_block;
+    *out_count = block_count;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_serial_reader_get_element_size(const GDSSerialReader* reader)
+{
+    return (reader != NULL) ? reader->_element_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_serial_reader_get_count(const GDSSerialReader* reader)
+{
+    return (reader != NULL) ? reader->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_serial_reader_get_remaining_count(const GDSSerialReader* reader)
+{
+    return (reader != NULL) ? reader->_remaining_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_serial_reader_get_struct_size()
+{
+    return sizeof(GDSSerialReader);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static void _gds_serial_header_fill(struct _GDSSerialHeader* header, size_t element_size, size_t count)
+{
+    memcpy(header->magic, _GDS_SERIAL_MAGIC, sizeof(header->magic));
+    header->version = GDS_SERIAL_VERSION;
+    header->header_size = sizeof(struct _GDSSerialHeader);
+    header->element_size = element_size;
+    header->count = count;
+}
+
+static gds_err _gds_serial_header_check(const struct _GDSSerialHeader* header, size_t* out_element_size,
+        size_t* out_count)
+{
+    if(memcmp(header->magic, _GDS_SERIAL_MAGIC, sizeof(header->magic)) != 0) return GDS_SERIAL_ERR_FILE_INVALID;
+    if(header->version != GDS_SERIAL_VERSION) return GDS_SERIAL_ERR_FILE_INVALID;
+    if(header->header_size != sizeof(struct _GDSSerialHeader)) return GDS_SERIAL_ERR_FILE_INVALID;
+    if(header->element_size == 0) return GDS_SERIAL_ERR_FILE_INVALID;
+    if((header->element_size > SIZE_MAX) || (header->count > SIZE_MAX)) return GDS_SERIAL_ERR_FILE_INVALID;
+    if((header->count > 0) && ((size_t)header->element_size > SIZE_MAX / (size_t)header->count))
+        return GDS_SERIAL_ERR_FILE_INVALID;
+
+    *out_element_size = (size_t)header->element_size;
+    *out_count = (size_t)header->count;
+
+    return GDS_SUCCESS;
+}
+
+static gds_err _gds_serial_writev_all(int fd, struct iovec* iov, int iov_count)
+{
+    while(iov_count > 0)
+    {
+        ssize_t written = writev(fd, iov, iov_count);
+        if(written < 0)
+        {
+            if(errno == EINTR) continue;
+            return GDS_SERIAL_ERR_WRITE_FAIL;
+        }
+
+        size_t left = (size_t)written;
+        while((iov_count > 0) && (left >= iov->iov_len))
+        {
+            left -= iov->iov_len;
+            iov++;
+            iov_count--;
+        }
+
+        if(iov_count > 0)
+        {
+            iov->iov_base = (char*)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+
+    return GDS_SUCCESS;
+}
+
+static gds_err _gds_serial_read_all(int fd, void* buff, size_t size, off_t offset)
+{
+    char* curr = (char*)buff;
+
+    while(size > 0)
+    {
+        ssize_t bytes_read = (offset >= 0) ? pread(fd, curr, size, offset) : read(fd, curr, size);
+        if(bytes_read < 0)
+        {
+            if(errno == EINTR) continue;
+            return GDS_SERIAL_ERR_READ_FAIL;
+        }
+        if(bytes_read == 0) return GDS_SERIAL_ERR_FILE_INVALID;
+
+        curr += bytes_read;
+        size -= (size_t)bytes_read;
+        if(offset >= 0) offset += bytes_read;
+    }
+
+    return GDS_SUCCESS;
+}
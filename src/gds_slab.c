@@ -0,0 +1,492 @@
+#include "gds.h"
+#include "gds_slab.h"
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_SLAB_DEF_ALLOW__
+#include "def/gds_slab_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// Objects start this many bytes into a chunk - the header size, rounded up so the first object is aligned like memory
+// returned by malloc().
+#define _GDS_SLAB_CHUNK_HEADER_SIZE ((sizeof(struct _GDSSlabChunk) + _Alignof(max_align_t) - 1) / \
+        _Alignof(max_align_t) * _Alignof(max_align_t))
+
+// Object count of the first chunk when chunks grow. Keeps a slab holding only a few objects small.
+#define _GDS_SLAB_FIRST_CHUNK_OBJECTS 4
+
+// Initial capacity of the array of chunks.
+#define _GDS_SLAB_FIRST_CHUNKS_CAPACITY 4
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Allocates a new chunk holding 'object_count' objects and adds it to the array of chunks. The chunk isn't linked
+ * into the list of partial chunks. Returns the new chunk, or NULL if allocating fails. Assumes non-NULL 'slab'. */
+static struct _GDSSlabChunk* _gds_slab_add_chunk(GDSSlab* slab, size_t object_count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks 'chunk' from the list of partial chunks, if it is in it, removes it from the array of chunks and frees it.
+ * Assumes non-NULL arguments. */
+static void _gds_slab_remove_chunk(GDSSlab* slab, struct _GDSSlabChunk* chunk);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Makes sure the array of chunks has room for 'count' chunks. Returns GDS_SUCCESS, or GDS_SLAB_ERR_MALLOC_FAIL if
+ * allocating fails - in that case, the array is unchanged. Assumes non-NULL 'slab'. */
+static gds_err _gds_slab_reserve_chunk_slots(GDSSlab* slab, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the position, in the array of chunks, of the chunk holding 'object'. Found by binary search - the array is
+ * sorted by address. Assumes non-NULL arguments and that 'object' is in one of the chunks of 'slab'. */
+static size_t _gds_slab_find_chunk_pos(const GDSSlab* slab, const void* object);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Links 'chunk' into the list of partial chunks, right after 'after' - or first, if 'after' is NULL. Assumes non-NULL
+ * 'slab' and 'chunk'. */
+static void _gds_slab_link_partial(GDSSlab* slab, struct _GDSSlabChunk* chunk, struct _GDSSlabChunk* after);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Unlinks 'chunk' from the list of partial chunks. Assumes non-NULL arguments and that 'chunk' is in the list. */
+static void _gds_slab_unlink_partial(GDSSlab* slab, struct _GDSSlabChunk* chunk);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Marks every object of 'chunk' as never used, so objects are carved from its start again. Assumes non-NULL
+ * argument. */
+static void _gds_slab_rewind_chunk(struct _GDSSlabChunk* chunk);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of the first object of 'chunk'. Assumes non-NULL 'chunk'. */
+static char* _gds_slab_get_chunk_objects(struct _GDSSlabChunk* chunk);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks if 'object' is one of the objects of 'chunk'. Assumes non-NULL arguments. */
+static bool _gds_slab_chunk_holds(struct _GDSSlabChunk* chunk, const void* object);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_slab_init(GDSSlab* slab, size_t object_size, size_t objects_per_chunk)
+{
+    if(slab == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(object_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    // freed objects hold a free list link, so they must be at least pointer-sized.
+    object_size = ((object_size + sizeof(void*) - 1) / sizeof(void*)) * sizeof(void*);
+
+    if(objects_per_chunk == 0)
+    {
+        slab->_max_chunk_objects = (GDS_SLAB_DEFAULT_CHUNK_SIZE - _GDS_SLAB_CHUNK_HEADER_SIZE) / object_size;
+        if(slab->_max_chunk_objects == 0) slab->_max_chunk_objects = 1;
+
+        slab->_chunk_objects = (slab->_max_chunk_objects < _GDS_SLAB_FIRST_CHUNK_OBJECTS) ?
+            slab->_max_chunk_objects : _GDS_SLAB_FIRST_CHUNK_OBJECTS;
+    }
+    else
+    {
+        slab->_max_chunk_objects = objects_per_chunk;
+        slab->_chunk_objects = objects_per_chunk;
+    }
+
+    slab->_object_size = object_size;
+    slab->_chunks = NULL;
+    slab->_chunk_count = 0;
+    slab->_chunks_capacity = 0;
+    slab->_partial_chunks = NULL;
+    slab->_capacity = 0;
+    slab->_used_count = 0;
+    slab->_peak_used_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSSlab* gds_slab_create(size_t object_size, size_t objects_per_chunk)
+{
+    GDSSlab* slab = (GDSSlab*)malloc(sizeof(GDSSlab));
+    if(slab == NULL) return NULL;
+
+    gds_err init_status = gds_slab_init(slab, object_size, objects_per_chunk);
+
+    if(init_status == GDS_SUCCESS) return slab;
+    else
+    {
+        free(slab);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_slab_destruct(GDSSlab* slab)
+{
+    if(slab == NULL) return;
+
+    size_t i;
+    for(i = 0; i < slab->_chunk_count; i++)
+        free(slab->_chunks[i]);
+
+    free(slab->_chunks);
+
+    slab->_object_size = 0;
+    slab->_chunk_objects = 0;
+    slab->_max_chunk_objects = 0;
+    slab->_chunks = NULL;
+    slab->_chunk_count = 0;
+    slab->_chunks_capacity = 0;
+    slab->_partial_chunks = NULL;
+    slab->_capacity = 0;
+    slab->_used_count = 0;
+    slab->_peak_used_count = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_slab_alloc(GDSSlab* slab)
+{
+    if(slab == NULL) return NULL;
+
+    struct _GDSSlabChunk* chunk = slab->_partial_chunks;
+
+    if(chunk == NULL)
+    {
+        chunk = _gds_slab_add_chunk(slab, slab->_chunk_objects);
+        if(chunk == NULL) return NULL;
+
+        _gds_slab_link_partial(slab, chunk, NULL);
+
+        if(slab->_chunk_objects < slab->_max_chunk_objects)
+        {
+            slab->_chunk_objects = (slab->_chunk_objects <= slab->_max_chunk_objects / 2) ?
+                slab->_chunk_objects * 2 : slab->_max_chunk_objects;
+        }
+    }
+
+    void* object;
+
+    if(chunk->free_list != NULL)
+    {
+        object = chunk->free_list;
+        chunk->free_list = chunk->free_list->next;
+    }
+    else
+    {
+        object = chunk->carve_pos;
+        chunk->carve_pos += slab->_object_size;
+    }
+
+    chunk->used_count++;
+    if(chunk->used_count == chunk->object_count) _gds_slab_unlink_partial(slab, chunk);
+
+    slab->_used_count++;
+    if(slab->_used_count > slab->_peak_used_count) slab->_peak_used_count = slab->_used_count;
+
+    return object;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_slab_free(GDSSlab* slab, void* object)
+{
+    if(slab == NULL) return;
+    if(object == NULL) return;
+
+    // objects are mostly freed close to where the previous ones were, so the first partial chunk is checked first.
+    struct _GDSSlabChunk* chunk = slab->_partial_chunks;
+    if((chunk == NULL) || !_gds_slab_chunk_holds(chunk, object))
+        chunk = slab->_chunks[_gds_slab_find_chunk_pos(slab, object)];
+
+    // a full chunk isn't in the list of partial chunks. It goes first, so the freed object is handed out next.
+    if(chunk->used_count == chunk->object_count) _gds_slab_link_partial(slab, chunk, NULL);
+
+    struct _GDSSlabFreeObject* freed = (struct _GDSSlabFreeObject*)object;
+    freed->next = chunk->free_list;
+    chunk->free_list = freed;
+
+    chunk->used_count--;
+    slab->_used_count--;
+
+    // an empty chunk is kept only if the other chunks can't hold as many objects as the slab has held at once, so
+    // refilling the slab doesn't allocate memory again. Chunks beyond that are freed, so memory doesn't pile up when
+    // objects come from other slabs(gds_slab_absorb()).
+    if(chunk->used_count == 0)
+    {
+        if(slab->_capacity - chunk->object_count >= slab->_peak_used_count) _gds_slab_remove_chunk(slab, chunk);
+        else _gds_slab_rewind_chunk(chunk);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_slab_reset(GDSSlab* slab)
+{
+    if(slab == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    slab->_partial_chunks = NULL;
+
+    // linked from the last chunk to the first, so chunks are reused in address order.
+    size_t i;
+    for(i = slab->_chunk_count; i > 0; i--)
+    {
+        _gds_slab_rewind_chunk(slab->_chunks[i - 1]);
+        _gds_slab_link_partial(slab, slab->_chunks[i - 1], NULL);
+    }
+
+    slab->_used_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_slab_reserve(GDSSlab* slab, size_t count)
+{
+    if(slab == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    // every object of every chunk that isn't in use can be allocated.
+    while(slab->_capacity - slab->_used_count < count)
+    {
+        size_t missing = count - (slab->_capacity - slab->_used_count);
+        size_t object_count = missing;
+        if(object_count < slab->_chunk_objects) object_count = slab->_chunk_objects;
+        if(object_count > slab->_max_chunk_objects) object_count = slab->_max_chunk_objects;
+
+        struct _GDSSlabChunk* chunk = _gds_slab_add_chunk(slab, object_count);
+        if(chunk == NULL) return GDS_SLAB_ERR_MALLOC_FAIL;
+
+        // after the first partial chunk, so allocating continues from it.
+        _gds_slab_link_partial(slab, chunk, slab->_partial_chunks);
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_slab_absorb(GDSSlab* dest, GDSSlab* src)
+{
+    if(dest == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(src == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if((dest == src) || (dest->_object_size != src->_object_size)) return GDS_GEN_ERR_INCONSISTENT_ARGS;
+
+    // chunks of 'src' with no objects in use are freed instead of moved.
+    size_t moved_count = 0;
+    size_t i;
+    for(i = 0; i < src->_chunk_count; i++)
+    {
+        if(src->_chunks[i]->used_count != 0) moved_count++;
+    }
+
+    if(_gds_slab_reserve_chunk_slots(dest, dest->_chunk_count + moved_count) != GDS_SUCCESS)
+        return GDS_SLAB_ERR_MALLOC_FAIL;
+
+    struct _GDSSlabChunk* partial = src->_partial_chunks;
+    while(partial != NULL)
+    {
+        struct _GDSSlabChunk* next = partial->next;
+
+        // after the first partial chunk of 'dest', so allocating continues from it.
+        if(partial->used_count != 0) _gds_slab_link_partial(dest, partial, dest->_partial_chunks);
+
+        partial = next;
+    }
+
+    // both arrays are sorted by address, so they are merged from the back, in place.
+    size_t dest_pos = dest->_chunk_count;
+    size_t merged_pos = dest->_chunk_count + moved_count;
+    for(i = src->_chunk_count; i > 0; i--)
+    {
+        struct _GDSSlabChunk* chunk = src->_chunks[i - 1];
+
+        if(chunk->used_count == 0)
+        {
+            free(chunk);
+            continue;
+        }
+
+        while((dest_pos > 0) && ((uintptr_t)dest->_chunks[dest_pos - 1] > (uintptr_t)chunk))
+        {
+            dest->_chunks[merged_pos - 1] = dest->_chunks[dest_pos - 1];
+            dest_pos--;
+            merged_pos--;
+        }
+
+        dest->_chunks[merged_pos - 1] = chunk;
+        merged_pos--;
+
+        dest->_capacity += chunk->object_count;
+    }
+
+    dest->_chunk_count += moved_count;
+    dest->_used_count += src->_used_count;
+    if(dest->_used_count > dest->_peak_used_count) dest->_peak_used_count = dest->_used_count;
+
+    src->_chunk_count = 0;
+    src->_partial_chunks = NULL;
+    src->_capacity = 0;
+    src->_used_count = 0;
+    src->_peak_used_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_slab_get_object_size(const GDSSlab* slab)
+{
+    return (slab != NULL) ? slab->_object_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_slab_get_used_count(const GDSSlab* slab)
+{
+    return (slab != NULL) ? slab->_used_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_slab_get_chunk_count(const GDSSlab* slab)
+{
+    return (slab != NULL) ? slab->_chunk_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_slab_get_capacity(const GDSSlab* slab)
+{
+    return (slab != NULL) ? slab->_capacity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_slab_get_struct_size()
+{
+    return sizeof(GDSSlab);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static struct _GDSSlabChunk* _gds_slab_add_chunk(GDSSlab* slab, size_t object_count)
+{
+    if(_gds_slab_reserve_chunk_slots(slab, slab->_chunk_count + 1) != GDS_SUCCESS) return NULL;
+
+    struct _GDSSlabChunk* chunk = (struct _GDSSlabChunk*)malloc(_GDS_SLAB_CHUNK_HEADER_SIZE +
+            (object_count * slab->_object_size));
+    if(chunk == NULL) return NULL;
+
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->object_count = object_count;
+    chunk->objects_end = _gds_slab_get_chunk_objects(chunk) + (object_count * slab->_object_size);
+    _gds_slab_rewind_chunk(chunk);
+
+    size_t pos = slab->_chunk_count;
+    while((pos > 0) && ((uintptr_t)slab->_chunks[pos - 1] > (uintptr_t)chunk))
+    {
+        slab->_chunks[pos] = slab->_chunks[pos - 1];
+        pos--;
+    }
+
+    slab->_chunks[pos] = chunk;
+    slab->_chunk_count++;
+    slab->_capacity += object_count;
+
+    return chunk;
+}
+
+static void _gds_slab_remove_chunk(GDSSlab* slab, struct _GDSSlabChunk* chunk)
+{
+    if(chunk->used_count != chunk->object_count) _gds_slab_unlink_partial(slab, chunk);
+
+    size_t pos;
+    for(pos = _gds_slab_find_chunk_pos(slab, chunk); pos + 1 < slab->_chunk_count; pos++)
+        slab->_chunks[pos] = slab->_chunks[pos + 1];
+
+    slab->_chunk_count--;
+    slab->_capacity -= chunk->object_count;
+
+    free(chunk);
+}
+
+static gds_err _gds_slab_reserve_chunk_slots(GDSSlab* slab, size_t count)
+{
+    if(count <= slab->_chunks_capacity) return GDS_SUCCESS;
+
+    size_t new_capacity = (slab->_chunks_capacity != 0) ? slab->_chunks_capacity : _GDS_SLAB_FIRST_CHUNKS_CAPACITY;
+    while(new_capacity < count) new_capacity *= 2;
+
+    struct _GDSSlabChunk** new_chunks = (struct _GDSSlabChunk**)realloc(slab->_chunks,
+            new_capacity * sizeof(struct _GDSSlabChunk*));
+    if(new_chunks == NULL) return GDS_SLAB_ERR_MALLOC_FAIL;
+
+    slab->_chunks = new_chunks;
+    slab->_chunks_capacity = new_capacity;
+
+    return GDS_SUCCESS;
+}
+
+static size_t _gds_slab_find_chunk_pos(const GDSSlab* slab, const void* object)
+{
+    // the last chunk starting at or before 'object'.
+    size_t low = 0;
+    size_t high = slab->_chunk_count;
+    while(high - low > 1)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if((uintptr_t)slab->_chunks[mid] <= (uintptr_t)object) low = mid;
+        else high = mid;
+    }
+
+    return low;
+}
+
+static void _gds_slab_link_partial(GDSSlab* slab, struct _GDSSlabChunk* chunk, struct _GDSSlabChunk* after)
+{
+    chunk->prev = after;
+    chunk->next = (after != NULL) ? after->next : slab->_partial_chunks;
+
+    if(chunk->next != NULL) chunk->next->prev = chunk;
+
+    if(after != NULL) after->next = chunk;
+    else slab->_partial_chunks = chunk;
+}
+
+static void _gds_slab_unlink_partial(GDSSlab* slab, struct _GDSSlabChunk* chunk)
+{
+    if(chunk->prev != NULL) chunk->prev->next = chunk->next;
+    else slab->_partial_chunks = chunk->next;
+
+    if(chunk->next != NULL) chunk->next->prev = chunk->prev;
+
+    chunk->prev = NULL;
+    chunk->next = NULL;
+}
+
+static void _gds_slab_rewind_chunk(struct _GDSSlabChunk* chunk)
+{
+    chunk->free_list = NULL;
+    chunk->carve_pos = _gds_slab_get_chunk_objects(chunk);
+    chunk->used_count = 0;
+}
+
+static char* _gds_slab_get_chunk_objects(struct _GDSSlabChunk* chunk)
+{
+    return ((char*)chunk + _GDS_SLAB_CHUNK_HEADER_SIZE);
+}
+
+static bool _gds_slab_chunk_holds(struct _GDSSlabChunk* chunk, const void* object)
+{
+    return (((uintptr_t)object >= (uintptr_t)_gds_slab_get_chunk_objects(chunk)) &&
+            ((uintptr_t)object < (uintptr_t)chunk->objects_end));
+}
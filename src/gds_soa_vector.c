@@ -0,0 +1,304 @@
+#include "gds.h"
+#include "gds_array.h"
+#include "gds_soa_vector.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_SOA_VECTOR_DEF_ALLOW__
+#include "def/gds_soa_vector_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Grows all columns to 'new_capacity' records. If growing a column fails, the columns that were already grown keep
+ * their new capacity, but the vector's capacity stays the same - so all columns can always hold '_capacity'
+ * records. Assumes non-NULL 'soa'. */
+static gds_err _gds_soa_vector_grow(GDSSoAVector* soa, size_t new_capacity);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Checks that 'fields' and all of the pointers it holds are non-NULL. Assumes non-NULL 'soa'. */
+static bool _gds_soa_vector_fields_valid(const GDSSoAVector* soa, const void* const* fields);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_init(GDSSoAVector* soa, const size_t* field_sizes, size_t field_count, size_t initial_capacity,
+        double resize_factor)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(field_sizes == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(field_count == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(initial_capacity == 0) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(resize_factor <= GDS_SOA_MIN_RESIZE_FACTOR) return GDS_GEN_ERR_INVALID_ARG(5);
+
+    size_t i;
+    for(i = 0; i < field_count; i++)
+        if(field_sizes[i] == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    soa->_columns = (struct GDSArray*)malloc(field_count * sizeof(struct GDSArray));
+    if(soa->_columns == NULL) return GDS_SOA_ERR_MALLOC_FAIL;
+
+    for(i = 0; i < field_count; i++)
+    {
+        if(gds_array_init(&soa->_columns[i], initial_capacity, field_sizes[i]) != GDS_SUCCESS)
+        {
+            while(i > 0) gds_array_destruct(&soa->_columns[--i]);
+            free(soa->_columns);
+            soa->_columns = NULL;
+
+            return GDS_SOA_ERR_MALLOC_FAIL;
+        }
+    }
+
+    soa->_field_count = field_count;
+    soa->_count = 0;
+    soa->_capacity = initial_capacity;
+    soa->_resize_factor = resize_factor;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSSoAVector* gds_soa_vector_create(const size_t* field_sizes, size_t field_count, size_t initial_capacity,
+        double resize_factor)
+{
+    GDSSoAVector* soa = (GDSSoAVector*)malloc(sizeof(GDSSoAVector));
+    if(soa == NULL) return NULL;
+
+    gds_err init_status = gds_soa_vector_init(soa, field_sizes, field_count, initial_capacity, resize_factor);
+
+    if(init_status == GDS_SUCCESS) return soa;
+    else
+    {
+        free(soa);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_soa_vector_destruct(GDSSoAVector* soa)
+{
+    if(soa == NULL) return;
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++) gds_array_destruct(&soa->_columns[i]);
+    free(soa->_columns);
+
+    soa->_columns = NULL;
+    soa->_field_count = 0;
+    soa->_count = 0;
+    soa->_capacity = 0;
+    soa->_resize_factor = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_soa_vector_at(const GDSSoAVector* soa, size_t field, size_t pos)
+{
+    if(soa == NULL) return NULL;
+    if(field >= soa->_field_count) return NULL;
+    if(pos >= soa->_count) return NULL;
+
+    return (char*)soa->_columns[field]._data + (pos * soa->_columns[field]._element_size);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_soa_vector_get_column(const GDSSoAVector* soa, size_t field)
+{
+    if(soa == NULL) return NULL;
+    if(field >= soa->_field_count) return NULL;
+
+    return soa->_columns[field]._data;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_get_record(const GDSSoAVector* soa, size_t pos, void* const* out_fields)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= soa->_count) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(!_gds_soa_vector_fields_valid(soa, (const void* const*)out_fields)) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++)
+        memcpy(out_fields[i], gds_array_at(&soa->_columns[i], pos), soa->_columns[i]._element_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_assign(GDSSoAVector* soa, const void* const* fields, size_t pos)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(!_gds_soa_vector_fields_valid(soa, fields)) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos >= soa->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++) gds_array_assign(&soa->_columns[i], fields[i], pos);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_push_back(GDSSoAVector* soa, const void* const* fields)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_soa_vector_insert_at(soa, fields, soa->_count);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_insert_at(GDSSoAVector* soa, const void* const* fields, size_t pos)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(!_gds_soa_vector_fields_valid(soa, fields)) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos > soa->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    // all columns are grown before any of them is changed, so a failed growth leaves the records untouched.
+    if(soa->_count == soa->_capacity)
+    {
+        size_t new_capacity = (size_t)(soa->_capacity * soa->_resize_factor);
+        if(new_capacity <= soa->_capacity) new_capacity = soa->_capacity + 1;
+
+        gds_err grow_status = _gds_soa_vector_grow(soa, new_capacity);
+        if(grow_status != GDS_SUCCESS) return grow_status;
+    }
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++) gds_array_insert_at(&soa->_columns[i], fields[i], pos);
+
+    soa->_count++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_remove_at(GDSSoAVector* soa, size_t pos)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= soa->_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++) gds_array_remove_at(&soa->_columns[i], pos);
+
+    soa->_count--;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_pop_back(GDSSoAVector* soa)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(soa->_count == 0) return GDS_SOA_ERR_SOA_EMPTY;
+
+    return gds_soa_vector_remove_at(soa, soa->_count - 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_empty(GDSSoAVector* soa)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++) gds_array_empty(&soa->_columns[i]);
+
+    soa->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_soa_vector_reserve(GDSSoAVector* soa, size_t new_capacity)
+{
+    if(soa == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    if(new_capacity <= soa->_capacity) return GDS_SUCCESS;
+
+    return _gds_soa_vector_grow(soa, new_capacity);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_soa_vector_get_count(const GDSSoAVector* soa)
+{
+    return (soa != NULL) ? soa->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_soa_vector_get_capacity(const GDSSoAVector* soa)
+{
+    return (soa != NULL) ? soa->_capacity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_soa_vector_is_empty(const GDSSoAVector* soa)
+{
+    return (soa != NULL) ? (soa->_count == 0) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_soa_vector_get_field_count(const GDSSoAVector* soa)
+{
+    return (soa != NULL) ? soa->_field_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_soa_vector_get_field_size(const GDSSoAVector* soa, size_t field)
+{
+    if(soa == NULL) return 0;
+    if(field >= soa->_field_count) return 0;
+
+    return soa->_columns[field]._element_size;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_soa_vector_get_struct_size()
+{
+    return sizeof(GDSSoAVector);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static gds_err _gds_soa_vector_grow(GDSSoAVector* soa, size_t new_capacity)
+{
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++)
+    {
+        if(soa->_columns[i]._capacity >= new_capacity) continue;
+
+        if(gds_array_realloc(&soa->_columns[i], new_capacity) != GDS_SUCCESS) return GDS_SOA_ERR_REALLOC_FAIL;
+    }
+
+    soa->_capacity = new_capacity;
+
+    return GDS_SUCCESS;
+}
+
+static bool _gds_soa_vector_fields_valid(const GDSSoAVector* soa, const void* const* fields)
+{
+    if(fields == NULL) return false;
+
+    size_t i;
+    for(i = 0; i < soa->_field_count; i++)
+        if(fields[i] == NULL) return false;
+
+    return true;
+}
@@ -0,0 +1,210 @@
+#include "gds.h"
+#include "gds_spsc_queue.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_SPSC_QUEUE_DEF_ALLOW__
+#include "def/gds_spsc_queue_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Copies 'count' elements from 'src' into the ring buffer, starting at position 'pos'. Handles the wrap-around at the
+ * end of the buffer. */
+static void _gds_spsc_queue_copy_in(GDSSPSCQueue* queue, size_t pos, const void* src, size_t count);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Copies 'count' elements from the ring buffer, starting at position 'pos', into 'dest'. Handles the wrap-around at
+ * the end of the buffer. */
+static void _gds_spsc_queue_copy_out(const GDSSPSCQueue* queue, size_t pos, void* dest, size_t count);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_spsc_queue_init(GDSSPSCQueue* queue, size_t element_size, size_t capacity)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(capacity == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    size_t rounded_capacity = 1;
+    while(rounded_capacity < capacity) rounded_capacity <<= 1;
+
+    queue->_data = malloc(rounded_capacity * element_size);
+    if(queue->_data == NULL) return GDS_SPSC_ERR_MALLOC_FAIL;
+
+    queue->_capacity = rounded_capacity;
+    queue->_element_size = element_size;
+    queue->_cached_head = 0;
+    queue->_cached_tail = 0;
+    atomic_init(&queue->_head, 0);
+    atomic_init(&queue->_tail, 0);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSSPSCQueue* gds_spsc_queue_create(size_t element_size, size_t capacity)
+{
+    GDSSPSCQueue* queue = (GDSSPSCQueue*)aligned_alloc(GDS_CACHE_LINE_SIZE, sizeof(GDSSPSCQueue));
+    if(queue == NULL) return NULL;
+
+    gds_err init_status = gds_spsc_queue_init(queue, element_size, capacity);
+
+    if(init_status == GDS_SUCCESS) return queue;
+    else
+    {
+        free(queue);
+        return NULL;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_spsc_queue_destruct(GDSSPSCQueue* queue)
+{
+    if(queue == NULL) return;
+
+    free(queue->_data);
+
+    queue->_data = NULL;
+    queue->_capacity = 0;
+    queue->_element_size = 0;
+    atomic_store_explicit(&queue->_head, 0, memory_order_relaxed);
+    atomic_store_explicit(&queue->_tail, 0, memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_spsc_queue_enqueue(GDSSPSCQueue* queue, const void* data)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    return (gds_spsc_queue_enqueue_n(queue, data, 1) == 1) ? GDS_SUCCESS : GDS_SPSC_ERR_QUEUE_FULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_spsc_queue_dequeue(GDSSPSCQueue* queue, void* out)
+{
+    if(queue == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(out == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    return (gds_spsc_queue_dequeue_n(queue, out, 1) == 1) ? GDS_SUCCESS : GDS_SPSC_ERR_QUEUE_EMPTY;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_spsc_queue_enqueue_n(GDSSPSCQueue* queue, const void* data, size_t count)
+{
+    if(queue == NULL) return 0;
+    if(data == NULL) return 0;
+
+    size_t tail = atomic_load_explicit(&queue->_tail, memory_order_relaxed);
+    size_t free_count = queue->_capacity - (tail - queue->_cached_head);
+
+    if(free_count < count)
+    {
+        // acquire - the consumer must be done reading the slots before they are overwritten.
+        queue->_cached_head = atomic_load_explicit(&queue->_head, memory_order_acquire);
+        free_count = queue->_capacity - (tail - queue->_cached_head);
+    }
+
+    if(count > free_count) count = free_count;
+    if(count == 0) return 0;
+
+    _gds_spsc_queue_copy_in(queue, tail, data, count);
+
+    atomic_store_explicit(&queue->_tail, tail + count, memory_order_release);
+
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_spsc_queue_dequeue_n(GDSSPSCQueue* queue, void* out, size_t max_count)
+{
+    if(queue == NULL) return 0;
+    if(out == NULL) return 0;
+
+    size_t head = atomic_load_explicit(&queue->_head, memory_order_relaxed);
+    size_t available = queue->_cached_tail - head;
+
+    if(available < max_count)
+    {
+        // acquire - the elements must be fully written before they are read.
+        queue->_cached_tail = atomic_load_explicit(&queue->_tail, memory_order_acquire);
+        available = queue->_cached_tail - head;
+    }
+
+    size_t count = (max_count < available) ? max_count : available;
+    if(count == 0) return 0;
+
+    _gds_spsc_queue_copy_out(queue, head, out, count);
+
+    atomic_store_explicit(&queue->_head, head + count, memory_order_release);
+
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_spsc_queue_get_count(const GDSSPSCQueue* queue)
+{
+    if(queue == NULL) return 0;
+
+    size_t head = atomic_load_explicit(&((GDSSPSCQueue*)queue)->_head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&((GDSSPSCQueue*)queue)->_tail, memory_order_acquire);
+
+    return (tail >= head) ? (tail - head) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_spsc_queue_get_capacity(const GDSSPSCQueue* queue)
+{
+    return (queue != NULL) ? queue->_capacity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_spsc_queue_get_element_size(const GDSSPSCQueue* queue)
+{
+    return (queue != NULL) ? queue->_element_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_spsc_queue_get_struct_size()
+{
+    return sizeof(GDSSPSCQueue);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static void _gds_spsc_queue_copy_in(GDSSPSCQueue* queue, size_t pos, const void* src, size_t count)
+{
+    size_t element_size = queue->_element_size;
+    size_t slot = pos & (queue->_capacity - 1);
+    size_t first_count = queue->_capacity - slot;
+    if(first_count > count) first_count = count;
+
+    memcpy((char*)queue->_data + (slot * element_size), src, first_count * element_size);
+    memcpy(queue->_data, (const char*)src + (first_count * element_size), (count - first_count) * element_size);
+}
+
+static void _gds_spsc_queue_copy_out(const GDSSPSCQueue* queue, size_t pos, void* dest, size_t count)
+{
+    size_t element_size = queue->_element_size;
+    size_t slot = pos & (queue->_capacity - 1);
+    size_t first_count = queue->_capacity - slot;
+    if(first_count > count) first_count = count;
+
+    memcpy(dest, (const char*)queue->_data + (slot * element_size), first_count * element_size);
+    memcpy((char*)dest + (first_count * element_size), queue->_data, (count - first_count) * element_size);
+}
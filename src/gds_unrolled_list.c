@@ -0,0 +1,507 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "gds.h"
+#include "gds_misc.h"
+#include "gds_unrolled_list.h"
+
+#ifdef GDS_ENABLE_OPAQUE_STRUCTS
+#define __GDS_UNROLLED_LIST_DEF_ALLOW__
+#include "def/gds_unrolled_list_def.h"
+#endif // GDS_ENABLE_OPAQUE_STRUCTS
+
+typedef struct _GDSUnrolledListNode _GDSUnrolledListNode;
+
+// Nodes are sized to fill about this many bytes, header included.
+#define _GDS_UNROLLED_LIST_TARGET_NODE_SIZE (2 * GDS_CACHE_LINE_SIZE)
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+/* Allocates an empty node, aligned to a cache line. Returns NULL if it fails. The function assumes non-NULL 'list'. */
+static _GDSUnrolledListNode* _gds_unrolled_list_alloc_node(const GDSUnrolledList* list);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Returns the address of element with index 'index' inside 'node'. The function assumes non-NULL arguments. */
+static inline void* _gds_unrolled_list_node_at(const GDSUnrolledList* list, _GDSUnrolledListNode* node, size_t index);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Finds the node holding the element with index 'pos'. Stores the index of the element inside the node into
+ * 'out_index' and, if 'out_prev' is non-NULL, the node before the found one(NULL for the head) into 'out_prev'.
+ * Function assumes non-NULL 'list' and 'out_index' and that 'pos' is in bounds. */
+static _GDSUnrolledListNode* _gds_unrolled_list_find_node(const GDSUnrolledList* list, size_t pos, size_t* out_index,
+        _GDSUnrolledListNode** out_prev);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Inserts 'data' at index 'index' of 'node', shifting the following elements of the node. Assumes the node isn't
+ * full. The function assumes non-NULL arguments. */
+static void _gds_unrolled_list_node_insert(GDSUnrolledList* list, _GDSUnrolledListNode* node, size_t index,
+        const void* data);
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_init(GDSUnrolledList* list, size_t data_size, void (*_on_element_removal_func)(void*))
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t header_size = sizeof(_GDSUnrolledListNode);
+
+    size_t node_capacity = (_GDS_UNROLLED_LIST_TARGET_NODE_SIZE > header_size + data_size) ?
+        (_GDS_UNROLLED_LIST_TARGET_NODE_SIZE - header_size) / data_size : 1;
+
+    size_t node_size = header_size + (node_capacity * data_size);
+    node_size = (node_size + GDS_CACHE_LINE_SIZE - 1) & ~((size_t)GDS_CACHE_LINE_SIZE - 1);
+
+    list->_count = 0;
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_data_size = data_size;
+    list->_node_capacity = node_capacity;
+    list->_node_size = node_size;
+    list->_on_element_removal_func = _on_element_removal_func;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSUnrolledList* gds_unrolled_list_create(size_t data_size, void (*_on_element_removal_func)(void*))
+{
+    if(data_size == 0) return NULL;
+
+    GDSUnrolledList* new_list = (GDSUnrolledList*)malloc(sizeof(GDSUnrolledList));
+    if(new_list == NULL) return NULL;
+
+    gds_err init_status = gds_unrolled_list_init(new_list, data_size, _on_element_removal_func);
+
+    if(init_status != GDS_SUCCESS)
+    {
+        free(new_list);
+        return NULL;
+    }
+
+    else return new_list;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void gds_unrolled_list_destruct(GDSUnrolledList* list)
+{
+    if(list == NULL) return;
+
+    gds_unrolled_list_empty(list);
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_data_size = 0;
+    list->_count = 0;
+    list->_node_capacity = 0;
+    list->_node_size = 0;
+    list->_on_element_removal_func = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_unrolled_list_at(const GDSUnrolledList* list, size_t pos)
+{
+    if(list == NULL) return NULL;
+    if(pos >= list->_count) return NULL;
+
+    size_t index;
+    _GDSUnrolledListNode* node = _gds_unrolled_list_find_node(list, pos, &index, NULL);
+
+    return _gds_unrolled_list_node_at(list, node, index);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_assign(GDSUnrolledList* list, const void* data, size_t pos)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos >= list->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    void* address = gds_unrolled_list_at(list, pos);
+    memcpy(address, data, list->_data_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_swap(GDSUnrolledList* list, size_t pos1, size_t pos2, void* swap_buff)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos1 >= list->_count) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos2 >= list->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(swap_buff == NULL) return GDS_GEN_ERR_INVALID_ARG(4);
+
+    if(pos1 == pos2) return GDS_SUCCESS;
+
+    void* data1 = gds_unrolled_list_at(list, pos1);
+    void* data2 = gds_unrolled_list_at(list, pos2);
+
+    gds_misc_swap(data1, data2, swap_buff, list->_data_size);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_push_back(GDSUnrolledList* list, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if((list->_tail == NULL) || (list->_tail->count == list->_node_capacity))
+    {
+        _GDSUnrolledListNode* new = _gds_unrolled_list_alloc_node(list);
+        if(new == NULL) return GDS_UNRLIST_ERR_MALLOC_FAIL;
+
+        if(list->_tail == NULL) list->_head = new;
+        else list->_tail->next = new;
+
+        list->_tail = new;
+    }
+
+    _gds_unrolled_list_node_insert(list, list->_tail, list->_tail->count, data);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_push_front(GDSUnrolledList* list, const void* data)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    // a full head isn't split - a new head is added, so repeated pushes to the front leave full nodes behind.
+    if((list->_head == NULL) || (list->_head->count == list->_node_capacity))
+    {
+        _GDSUnrolledListNode* new = _gds_unrolled_list_alloc_node(list);
+        if(new == NULL) return GDS_UNRLIST_ERR_MALLOC_FAIL;
+
+        new->next = list->_head;
+        list->_head = new;
+
+        if(list->_tail == NULL) list->_tail = new;
+    }
+
+    _gds_unrolled_list_node_insert(list, list->_head, 0, data);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_insert_at(GDSUnrolledList* list, const void* data, size_t pos)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(data == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(pos > list->_count) return GDS_GEN_ERR_INVALID_ARG(3);
+
+    if(pos == list->_count) return gds_unrolled_list_push_back(list, data);
+
+    size_t index;
+    _GDSUnrolledListNode* node = _gds_unrolled_list_find_node(list, pos, &index, NULL);
+
+    if(node->count == list->_node_capacity)
+    {
+        _GDSUnrolledListNode* new = _gds_unrolled_list_alloc_node(list);
+        if(new == NULL) return GDS_UNRLIST_ERR_MALLOC_FAIL;
+
+        // the upper half of the elements moves to the new node, which is linked after 'node'.
+        size_t half = node->count / 2;
+        new->count = node->count - half;
+        memcpy(_gds_unrolled_list_node_at(list, new, 0), _gds_unrolled_list_node_at(list, node, half),
+                new->count * list->_data_size);
+        node->count = half;
+
+        new->next = node->next;
+        node->next = new;
+        if(list->_tail == node) list->_tail = new;
+
+        if(index > half)
+        {
+            node = new;
+            index -= half;
+        }
+    }
+
+    _gds_unrolled_list_node_insert(list, node, index, data);
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_pop_front(GDSUnrolledList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(list->_count == 0) return GDS_UNRLIST_ERR_LIST_EMPTY;
+
+    return gds_unrolled_list_remove_at(list, 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_remove_at(GDSUnrolledList* list, size_t pos)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(pos >= list->_count) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    size_t index;
+    _GDSUnrolledListNode* prev;
+    _GDSUnrolledListNode* node = _gds_unrolled_list_find_node(list, pos, &index, &prev);
+
+    size_t data_size = list->_data_size;
+    void* removed = _gds_unrolled_list_node_at(list, node, index);
+
+    if(list->_on_element_removal_func != NULL) list->_on_element_removal_func(removed);
+
+    memmove(removed, (char*)removed + data_size, (node->count - index - 1) * data_size);
+    node->count--;
+    list->_count--;
+
+    if(node->count == 0)
+    {
+        if(prev != NULL) prev->next = node->next;
+        else list->_head = node->next;
+
+        if(list->_tail == node) list->_tail = prev;
+
+        free(node);
+    }
+    else if((node->count < list->_node_capacity / 2) && (node->next != NULL) &&
+            (node->count + node->next->count <= list->_node_capacity))
+    {
+        _GDSUnrolledListNode* next = node->next;
+
+        memcpy(_gds_unrolled_list_node_at(list, node, node->count), _gds_unrolled_list_node_at(list, next, 0),
+                next->count * data_size);
+        node->count += next->count;
+
+        node->next = next->next;
+        if(list->_tail == next) list->_tail = node;
+
+        free(next);
+    }
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_empty(GDSUnrolledList* list)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    _GDSUnrolledListNode* node = list->_head;
+    while(node != NULL)
+    {
+        if(list->_on_element_removal_func != NULL)
+        {
+            size_t i;
+            for(i = 0; i < node->count; i++)
+                list->_on_element_removal_func(_gds_unrolled_list_node_at(list, node, i));
+        }
+
+        _GDSUnrolledListNode* next = node->next;
+        free(node);
+        node = next;
+    }
+
+    list->_head = NULL;
+    list->_tail = NULL;
+    list->_count = 0;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_unrolled_list_is_empty(const GDSUnrolledList* list)
+{
+    if(list == NULL) return true;
+
+    return (list->_count == 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_unrolled_list_get_count(const GDSUnrolledList* list)
+{
+    return (list != NULL) ? list->_count : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_unrolled_list_get_data_size(const GDSUnrolledList* list)
+{
+    return (list != NULL) ? list->_data_size : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_unrolled_list_get_node_capacity(const GDSUnrolledList* list)
+{
+    return (list != NULL) ? list->_node_capacity : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_unrolled_list_get_struct_size()
+{
+    return sizeof(GDSUnrolledList);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_iterator_init(GDSUnrolledList* list, GDSUnrolledListIterator* iterator)
+{
+    if(list == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    if(list->_count == 0) return GDS_UNRLIST_ERR_LIST_EMPTY;
+
+    iterator->_curr_node = list->_head;
+    iterator->_index = 0;
+    iterator->_pos = 0;
+    iterator->_data_size = list->_data_size;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GDSUnrolledListIterator* gds_unrolled_list_iterator_create(GDSUnrolledList* list)
+{
+    if(list == NULL) return NULL;
+
+    GDSUnrolledListIterator* iterator = (GDSUnrolledListIterator*)malloc(sizeof(GDSUnrolledListIterator));
+    if(iterator == NULL) return NULL;
+
+    gds_err init_status = gds_unrolled_list_iterator_init(list, iterator);
+
+    if(init_status != GDS_SUCCESS)
+    {
+        free(iterator);
+        return NULL;
+    }
+    else return iterator;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_unrolled_list_iterator_next(GDSUnrolledListIterator* iterator)
+{
+    if(iterator == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(iterator->_curr_node == NULL) return GDS_FAILURE;
+
+    if(iterator->_index + 1 < iterator->_curr_node->count) iterator->_index++;
+    else if(iterator->_curr_node->next != NULL)
+    {
+        iterator->_curr_node = iterator->_curr_node->next;
+        iterator->_index = 0;
+    }
+    else return GDS_UNRLIST_ITER_ERR_OUT_OF_BOUNDS;
+
+    iterator->_pos++;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool gds_unrolled_list_iterator_has_next(GDSUnrolledListIterator* iterator)
+{
+    if(iterator == NULL) return false;
+
+    return ((iterator->_index + 1 < iterator->_curr_node->count) || (iterator->_curr_node->next != NULL));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* gds_unrolled_list_iterator_get_data(GDSUnrolledListIterator* iterator)
+{
+    if(iterator == NULL) return NULL;
+
+    return (char*)iterator->_curr_node + sizeof(_GDSUnrolledListNode) + (iterator->_index * iterator->_data_size);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t gds_unrolled_list_iterator_get_pos(GDSUnrolledListIterator* iterator)
+{
+    return (iterator != NULL) ? iterator->_pos : 0;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------
+
+static _GDSUnrolledListNode* _gds_unrolled_list_alloc_node(const GDSUnrolledList* list)
+{
+    assert(list != NULL);
+
+    _GDSUnrolledListNode* new = (_GDSUnrolledListNode*)aligned_alloc(GDS_CACHE_LINE_SIZE, list->_node_size);
+    if(new == NULL) return NULL;
+
+    new->next = NULL;
+    new->count = 0;
+
+    return new;
+}
+
+static inline void* _gds_unrolled_list_node_at(const GDSUnrolledList* list, _GDSUnrolledListNode* node, size_t index)
+{
+    return (char*)node + sizeof(_GDSUnrolledListNode) + (index * list->_data_size);
+}
+
+static _GDSUnrolledListNode* _gds_unrolled_list_find_node(const GDSUnrolledList* list, size_t pos, size_t* out_index,
+        _GDSUnrolledListNode** out_prev)
+{
+    assert(list != NULL);
+    assert(pos < list->_count);
+
+    size_t tail_start = list->_count - list->_tail->count;
+
+    // the node before the tail is only known after a walk.
+    if((pos >= tail_start) && (out_prev == NULL))
+    {
+        *out_index = pos - tail_start;
+        return list->_tail;
+    }
+
+    _GDSUnrolledListNode* prev = NULL;
+    _GDSUnrolledListNode* it = list->_head;
+    while(pos >= it->count)
+    {
+        pos -= it->count;
+        prev = it;
+        it = it->next;
+    }
+
+    *out_index = pos;
+    if(out_prev != NULL) *out_prev = prev;
+
+    return it;
+}
+
+static void _gds_unrolled_list_node_insert(GDSUnrolledList* list, _GDSUnrolledListNode* node, size_t index,
+        const void* data)
+{
+    assert(node->count < list->_node_capacity);
+
+    size_t data_size = list->_data_size;
+    void* dest = _gds_unrolled_list_node_at(list, node, index);
+
+    memmove((char*)dest + data_size, dest, (node->count - index) * data_size);
+    memcpy(dest, data, data_size);
+
+    node->count++;
+    list->_count++;
+}
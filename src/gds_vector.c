@@ -35,6 +35,56 @@ gds_err gds_vector_init(GDSVector* vector, size_t element_size, size_t initial_c
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+gds_err gds_vector_init_huge(GDSVector* vector, size_t element_size, size_t initial_capacity, double resize_factor)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(element_size == 0) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(initial_capacity == 0) return GDS_GEN_ERR_INVALID_ARG(3);
+    if(resize_factor <= GDS_VEC_MIN_RESIZE_FACTOR) return GDS_GEN_ERR_INVALID_ARG(4);
+
+    vector->_resize_factor = resize_factor;
+
+    gds_err init_status = gds_array_init_huge(&vector->_data, initial_capacity, element_size);
+
+    if(init_status == GDS_SUCCESS) return GDS_SUCCESS;
+    else if((init_status == GDS_ARR_ERR_MMAP_FAIL) || (init_status == GDS_ARR_ERR_STORAGE_UNSUPPORTED))
+        return init_status;
+    else return GDS_GEN_ERR_INTERNAL_ERR;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_vector_init_file(GDSVector* vector, const char* path, size_t element_size, size_t initial_capacity,
+        double resize_factor)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(path == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+    if(initial_capacity == 0) return GDS_GEN_ERR_INVALID_ARG(4);
+    if(resize_factor <= GDS_VEC_MIN_RESIZE_FACTOR) return GDS_GEN_ERR_INVALID_ARG(5);
+
+    vector->_resize_factor = resize_factor;
+
+    gds_err init_status = gds_array_init_file(&vector->_data, path, initial_capacity, element_size);
+
+    if(init_status == GDS_SUCCESS) return GDS_SUCCESS;
+    else if(init_status == GDS_GEN_ERR_INVALID_ARG(4)) return GDS_GEN_ERR_INVALID_ARG(3);
+    else if((init_status == GDS_ARR_ERR_FILE_OPEN_FAIL) || (init_status == GDS_ARR_ERR_FILE_INVALID) ||
+            (init_status == GDS_ARR_ERR_MMAP_FAIL) || (init_status == GDS_ARR_ERR_STORAGE_UNSUPPORTED))
+        return init_status;
+    else return GDS_GEN_ERR_INTERNAL_ERR;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_vector_flush(GDSVector* vector)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    return gds_array_flush(&vector->_data);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 GDSVector* gds_vector_create(size_t element_size, size_t initial_capacity, double resize_factor)
 {
     GDSVector* vector = (GDSVector*)malloc(sizeof(GDSVector));
@@ -234,6 +284,40 @@ ssize_t gds_vector_find(GDSVector* vector, const void* data, bool (*compare_func
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+ssize_t gds_vector_find_bytes(const GDSVector* vector, const void* data)
+{
+    if(vector == NULL) return -1;
+
+    return gds_array_find_bytes(&vector->_data, data);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_vector_sort(GDSVector* vector, int (*compare_func)(const void*, const void*))
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+    if(compare_func == NULL) return GDS_GEN_ERR_INVALID_ARG(2);
+
+    gds_err sort_status = gds_array_sort(&vector->_data, compare_func);
+    if(sort_status != GDS_SUCCESS) return GDS_GEN_ERR_INTERNAL_ERR;
+
+    return GDS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+gds_err gds_vector_radix_sort(GDSVector* vector, size_t key_offset, size_t key_width, bool key_signed)
+{
+    if(vector == NULL) return GDS_GEN_ERR_INVALID_ARG(1);
+
+    gds_err sort_status = gds_array_radix_sort(&vector->_data, key_offset, key_width, key_signed);
+
+    if(sort_status == GDS_ARR_ERR_MALLOC_FAIL) return GDS_VEC_ERR_MALLOC_FAIL;
+    else return sort_status;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 double gds_vector_get_resize_factor(const GDSVector* vector)
 {
     return (vector != NULL) ? vector->_resize_factor : -1;
@@ -1,5 +1,7 @@
 #include "gds_vector.h"
 #include "gds_hash_map.h"
+#include "gds_forward_list.h"
+#include "gds_slab.h"
 #include <assert.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -55,8 +57,49 @@ void init_hm(GDSHashMap* hm)
     printf("%d\n", *(int*)gds_hash_map_get(hm, &str2));
 }
 
+int compare_int_example(const void* a, const void* b)
+{
+    return (*(const int*)a - *(const int*)b);
+}
+
+/* A list filled every tick is moved into a batch list - spliced or merged - and the batch is then drained. The batch's
+ * slab takes over the chunks of the filled list on every move, and must free them again once drained - its capacity
+ * must stay bounded. */
+void test_forward_list_splice_drain()
+{
+    GDSSlab* batch_slab = gds_slab_create(gds_forward_list_get_node_size(sizeof(int)), 0);
+    GDSForwardList* batch = gds_forward_list_create_shared(sizeof(int), NULL, batch_slab);
+    GDSForwardList* tick_list = gds_forward_list_create(sizeof(int), NULL);
+
+    int tick;
+    for(tick = 0; tick < 2000; tick++)
+    {
+        int i;
+        for(i = 0; i < 1000; i++)
+            gds_forward_list_push_back(tick_list, &i);
+
+        if(tick % 2 == 0) assert(gds_forward_list_splice_back(batch, tick_list) == GDS_SUCCESS);
+        else assert(gds_forward_list_merge(batch, tick_list, compare_int_example) == GDS_SUCCESS);
+
+        assert(gds_forward_list_get_count(batch) == 1000);
+        while(gds_forward_list_pop_front(batch) == GDS_SUCCESS);
+
+        assert(gds_slab_get_used_count(batch_slab) == 0);
+        assert(gds_slab_get_capacity(batch_slab) <= 3000);
+    }
+
+    gds_forward_list_destruct(tick_list);
+    free(tick_list);
+    gds_forward_list_destruct(batch);
+    free(batch);
+    gds_slab_destruct(batch_slab);
+    free(batch_slab);
+}
+
 int main(int argc, char *argv[])
 {
+    test_forward_list_splice_drain();
+
     GDSHashMap* hm = gds_hash_map_create(sizeof(struct GDSString), sizeof(int), hash_func_example, key_compare_func_example);
 
     init_hm(hm);